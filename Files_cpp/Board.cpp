@@ -9,9 +9,12 @@
  */
 
 #include "../Files_h/Board.h"
+#include "../Files_h/Generator.h"
+#include "../Files_h/BoardPool.h"
 #include "../Files_h/Game_Constants.h"
 #include <iostream>
 #include <set>
+#include <deque>
 #include <cassert>
 #include <random>
 
@@ -51,6 +54,10 @@ Board::Board()
     gen = std::mt19937(rd());
     firstMove = true;
     mineHit = INVALID;
+    noGuess = false;
+    pool = NULL;
+    genStats.boardsTried = genStats.boardsRejected = 0;
+    genStats.seconds = 0;
 }
 
 
@@ -82,6 +89,7 @@ void Board::setBoard(int colNum, int rowNum, int numBombs)
     numCols = colNum;
     bombs = flags = numBombs;
     spacesLeft = (numCols * numRows) - numBombs;
+    changes.clear();
 
     /* initialize empty board */
     Cell EMPTY_CELL = {0, false, false};
@@ -94,6 +102,75 @@ void Board::setBoard(int colNum, int rowNum, int numBombs)
 }
 
 
+/*
+ * setSeed
+ * purpose: Seed the generator used to place the mines so the same seed and 
+ *          first move always deal the same board
+ * parameters:
+ *      unsigned seed : The seed
+ * returns: n/a
+ */
+void Board::setSeed(unsigned seed)
+{
+    gen.seed(seed);
+}
+
+/*
+ * setNoGuess
+ * purpose: Choose whether the first move deals a board that can be solved 
+ *          without guessing
+ * parameters:
+ *      bool noGuessing : True to deal a board that needs no guessing
+ * returns: n/a
+ */
+void Board::setNoGuess(bool noGuessing)
+{
+    noGuess = noGuessing;
+}
+
+/*
+ * setPool
+ * purpose: Take no guessing boards from the given pool when one is ready for
+ *          the first move
+ * parameters:
+ *      BoardPool *boardPool : The pool (NULL to always deal the board here)
+ * returns: n/a
+ * note: Only used when no guessing mode is on
+ */
+void Board::setPool(BoardPool *boardPool)
+{
+    pool = boardPool;
+}
+
+/*
+ * setLayout
+ * purpose: Place the mines at the given locations instead of dealing them 
+ *          randomly on the first move
+ * parameters:
+ *      const vector<Pos> &mines : The locations of every mine on the board
+ * returns: n/a
+ * effects: The first move no longer deals the board
+ * expectations: setBoard has been called, the number of mines matches the 
+ *               number of bombs and every location is in bounds. CRE if 
+ *               violated.
+ */
+void Board::setLayout(const vector<Pos> &mines)
+{
+    assert(mines.size() == bombs);
+
+    /* place each mine and update the numbers around it */
+    for (size_t i = 0; i < mines.size(); ++i) {
+        int row = mines[i].first, col = mines[i].second;
+        assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
+        bombLocs.insert(mines[i]);
+        mineField[row][col].val = MINE;
+        setNumbers(row, col);
+    }
+
+    firstMove = false;
+}
+
+
 /******************************************************\
  *                    Game moves                       *
 \******************************************************/
@@ -106,6 +183,7 @@ void Board::setBoard(int colNum, int rowNum, int numBombs)
  *      int col : The column of the cell the user would like to reveal
  * returns: The outcome of the move (numbered space revealed, open space,
  *          no space revealed, or mine hit) defined above.
+ * effects: The move is saved to the game record if the cell was hidden
  * expectations : The coordinates of the given cell are in bounds. CRE if 
  *                violated.
  */ 
@@ -120,31 +198,12 @@ int Board::move(int row, int col)
         firstMove = false;
     }
 
-    /* return if space is already shown */
-    if (mineField[row][col].shown) {
-        return NO_SPACE; 
-    }
-
-    /* check for mine hit and save location of mine if hit*/
-    if (mineField[row][col].val == MINE) {
-        mineHit = make_pair(row, col);
-        return MINE_HIT;
+    /* save the move to the game record if it reveals anything */
+    if (not mineField[row][col].shown) {
+        moves.push_back(make_pair(row, col));
     }
 
-    /* add flag back to total number if necessary */
-    if (mineField[row][col].flag) {
-        ++flags;        
-    }
-        
-    /* reveal adjacent spaces if open space */
-    mineField[row][col].shown = true;
-    --spacesLeft;
-    if (mineField[row][col].val == 0) {
-        openSpace(row, col);        
-        return OPEN_SPACE; 
-    } else {
-        return NUMBERED_SPACE;                
-    }
+    return reveal(row, col);
 }
 
 /*
@@ -175,6 +234,7 @@ bool Board::placeFlag(int row, int col)
     }
 
     /* flag was successfully placed/removed */
+    changes.push_back(make_pair(row, col));
     return true;
 }
 
@@ -260,6 +320,17 @@ int Board::getNumCols()
     return numCols;
 }
 
+/*
+ * getNumBombs
+ * purpose: Returns number of bombs on the board
+ * parameters: n/a
+ * returns: The number of bombs as an integer
+ */
+int Board::getNumBombs()
+{
+    return bombs;
+}
+
 /*
  * getNumber
  * purpose: Returns the number of adjacent bombs of the given cell
@@ -311,22 +382,190 @@ bool Board::revealMine()
     /* erase bomb from bomb locations set and reveal it on the board*/
     bombLocs.erase(make_pair(bombPos.first, bombPos.second));
     mineField[bombPos.first][bombPos.second].shown = true;
+    changes.push_back(bombPos);
 
     return true;
 }
 
 
+
+/******************************************************\
+ *                 Game Record Getters                 *
+\******************************************************/
+
+/*
+ * getMoves
+ * purpose: Returns the cells the user clicked on that revealed something
+ * parameters: n/a
+ * returns: The clicked cells in the order they were played
+ */
+vector<Pos> Board::getMoves()
+{
+    return moves;
+}
+
+/*
+ * getMines
+ * purpose: Returns the location of every mine on the board
+ * parameters: n/a
+ * returns: The mine locations in row major order (empty before the first 
+ *          move)
+ * note: Unlike bombLocs, this is unaffected by revealMine
+ */
+vector<Pos> Board::getMines()
+{
+    vector<Pos> mines;
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            if (mineField[row][col].val == MINE) {
+                mines.push_back(make_pair(row, col));
+            }
+        }
+    }
+    return mines;
+}
+
+/*
+ * getVisible
+ * purpose: Copy the board as the user sees it into the given vector
+ * parameters:
+ *      vector<int> &cells : Filled in row major order with the number of each
+ *                           revealed cell, MINE for revealed mines or HIDDEN
+ * returns: n/a
+ * note: Flags are not included since they may be wrong
+ */
+void Board::getVisible(vector<int> &cells)
+{
+    cells.resize(numRows * numCols);
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            Cell &cell = mineField[row][col];
+            cells[(row * numCols) + col] = cell.shown ? cell.val : HIDDEN;
+        }
+    }
+}
+
+/*
+ * getDrawn
+ * purpose: Copy the board as it is drawn into the given vector
+ * parameters:
+ *      vector<int> &cells : Filled in row major order with the number of each
+ *                           revealed cell, MINE for revealed mines, FLAGGED
+ *                           for flagged cells or HIDDEN
+ * returns: n/a
+ * note: Like getVisible, but with the flags
+ */
+void Board::getDrawn(vector<int> &cells)
+{
+    cells.resize(numRows * numCols);
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            cells[(row * numCols) + col] = getDrawnCell(row, col);
+        }
+    }
+}
+
+/*
+ * getDrawnCell
+ * purpose: Returns how one cell is drawn
+ * parameters:
+ *      int row : The row of the cell
+ *      int col : The column of the cell
+ * returns: The cell's number if revealed, MINE for a revealed mine, FLAGGED
+ *          if flagged or HIDDEN (as in getDrawn)
+ */
+int Board::getDrawnCell(int row, int col)
+{
+    Cell &cell = mineField[row][col];
+    int hidden = cell.flag ? FLAGGED : HIDDEN;
+    return cell.shown ? cell.val : hidden;
+}
+
+
+/*
+ * getGeneratorStats
+ * purpose: Returns the statistics of dealing a board that needs no guessing
+ * parameters: n/a
+ * returns: The boards tried and rejected and the time taken (all 0 if the 
+ *          board was dealt normally)
+ */
+generatorStats Board::getGeneratorStats()
+{
+    return genStats;
+}
+
+/*
+ * takeChanges
+ * purpose: Hand over the cells that were revealed, flagged or unflagged since
+ *          the last call
+ * parameters:
+ *      vector<Pos> &cells : Replaced with the changed cells, in the order
+ *                           they changed (a cell may appear more than once)
+ * returns: n/a
+ * note: Lets a renderer redraw only what changed instead of checking every
+ *       cell each frame
+ */
+void Board::takeChanges(vector<Pos> &cells)
+{
+    cells.clear();
+    cells.swap(changes);
+}
+
+
 /******************************************************\
  *                    Helper Funcs                     *
 \******************************************************/
 
+/*
+ * reveal
+ * purpose: Reveal the given cell and any open space connected to it
+ * parameters:
+ *      int row : The row of the cell to reveal
+ *      int col : The column of the cell to reveal
+ * returns: The outcome of revealing the cell (numbered space revealed, open 
+ *          space, no space revealed, or mine hit)
+ * expectations : The coordinates of the given cell are in bounds. CRE if 
+ *                violated.
+ */
+int Board::reveal(int row, int col)
+{
+    /* ensure coordinates are in bounds */
+    assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
+
+    /* return if space is already shown */
+    if (mineField[row][col].shown) {
+        return NO_SPACE; 
+    }
+
+    /* check for mine hit and save location of mine if hit*/
+    if (mineField[row][col].val == MINE) {
+        mineHit = make_pair(row, col);
+        return MINE_HIT;
+    }
+
+    /* reveal adjacent spaces if open space */
+    showCell(row, col);
+    if (mineField[row][col].val == 0) {
+        openSpace(row, col);        
+        return OPEN_SPACE; 
+    } else {
+        return NUMBERED_SPACE;                
+    }
+}
+
 /*
  * openSpace
- * purpose: Reveals the surrounding spaces of the chosen open space on the board
+ * purpose: Reveals the spaces around the chosen open space on the board, and
+ *          around every open space that reveals, until the opening is closed
+ *          off by numbers
  * parameters:
  *      int row : The row of the desired cell
  *      int col : The column of the desired cell
  * returns: n/a
+ * note: The cells are revealed (and logged for takeChanges) in order of
+ *       distance from the open space, so drawing them in order looks like a
+ *       wave. A queue is used instead of recursion so a huge opening can't
+ *       run out of stack.
  * expectations: The given cell coordinates are in bounds. CRE if violated
  */
 void Board::openSpace(int &row, int &col)
@@ -334,17 +573,54 @@ void Board::openSpace(int &row, int &col)
     /* ensure coordinates are in bounds */
     assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
 
-    /* reveal the blocks in the direct vicinty of the open space */
-    for (int i = 0; i < ADJACENT_BLOCKS; ++i) {
+    /* reveal the blocks in the direct vicinty of each open space */
+    deque<Pos> open(1, make_pair(row, col));
+    while (not open.empty()) {
+        Pos space = open.front();
+        open.pop_front();
+        for (int i = 0; i < ADJACENT_BLOCKS; ++i) {
+            int adjRow = space.first + R[i];
+            int adjCol = space.second + C[i];
+
+            /* check if in bounds */
+            bool rowInRange = ((adjRow >= 0) and (adjRow < numRows));
+            bool colInRange = ((adjCol >= 0) and (adjCol < numCols));
+
+            /* open spaces don't touch mines, so the cell is safe */
+            if ((rowInRange) and (colInRange) and (showCell(adjRow, adjCol))) {
+                if (mineField[adjRow][adjCol].val == 0) {
+                    open.push_back(make_pair(adjRow, adjCol));
+                }
+            }
+        }
+    }
+}
 
-        /* check if in bounds */
-        bool rowInRange = ((row + R[i] >= 0) and (row + R[i] < numRows));
-        bool colInRange = ((col + C[i] >= 0) and (col + C[i] < numCols));
+/*
+ * showCell
+ * purpose: Reveal a single cell that isn't a mine
+ * parameters:
+ *      int row : The row of the cell
+ *      int col : The column of the cell
+ * returns: True if the cell was hidden, false if it was already shown
+ * effects: A flag on the cell is given back and the cell is logged for
+ *          takeChanges
+ */
+bool Board::showCell(int row, int col)
+{
+    if (mineField[row][col].shown) {
+        return false;
+    }
 
-        if ((rowInRange) and (colInRange)) {
-            move(row + R[i], col + C[i]);
-        }
+    /* add flag back to total number if necessary */
+    if (mineField[row][col].flag) {
+        ++flags;
     }
+
+    mineField[row][col].shown = true;
+    changes.push_back(make_pair(row, col));
+    --spacesLeft;
+    return true;
 }
 
 /*
@@ -356,6 +632,8 @@ void Board::openSpace(int &row, int &col)
  * returns: n/a
  * effects: The bomb locations are set and saved and the adjacent spaces are
  *          incremented to represent the number of bombs it's touching
+ * note: In no guessing mode the board comes from the pool if it has one 
+ *       ready, and is dealt randomly only if the Generator can't find a board
  * expectations: The given cell coordinates are in bounds. CRE if violated
  */
 void Board::setBombs(int row, int col)
@@ -363,6 +641,22 @@ void Board::setBombs(int row, int col)
     /* ensure coordinates are in bounds */
     assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
 
+    /* deal a board that needs no guessing if asked (use a ready one if any) */
+    if (noGuess) {
+        vector<Pos> ready;
+        if ((pool != NULL) and pool->take(numRows, numCols, bombs, make_pair(row, col), ready)) {
+            setLayout(ready);
+            return;
+        }
+        Generator generator;
+        vector<Pos> mines = generator.generate(numRows, numCols, bombs, make_pair(row, col), gen());
+        genStats = generator.getStats();
+        if (not mines.empty()) {
+            setLayout(mines);
+            return;
+        }
+    }
+
     /* set distribution bounds for the row and col */
     int lowerRowBound = 0, upperRowBound = mineField.size() - 1;
     int lowerColBound = 0, upperColBound = mineField[0].size() - 1;
@@ -377,7 +671,7 @@ void Board::setBombs(int row, int col)
         int ranCol = dis2(gen);
 
         /* check if random coordinates are close to first move or duplicates */
-        bool close = (abs(ranRow - row) <= 2) and (abs(ranCol - col) <= 2);
+        bool close = (abs(ranRow - row) <= SAFE_RADIUS) and (abs(ranCol - col) <= SAFE_RADIUS);
         bool dupe = bombLocs.find(make_pair(ranRow, ranCol)) != bombLocs.end();
 
         /* add bomb and set numbers if not close and not a duplicate */
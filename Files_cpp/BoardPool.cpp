@@ -0,0 +1,250 @@
+/*
+ * Project: minesweeper
+ * Name: BoardPool.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the BoardPool class. A background thread fills
+ *          a slot for every first move of every difficulty with a no guessing
+ *          board, starting with the difficulty being played and the cells
+ *          closest to the middle. When the game takes a board the thread
+ *          deals a new one for that slot.
+ */
+
+#include "../Files_h/BoardPool.h"
+#include "../Files_h/Generator.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <random>
+#include <algorithm>
+
+/* the pool deals one board at a time to leave the other cores to the game */
+static const unsigned POOL_WORKERS = 1;
+
+
+/******************************************************\
+ *             Constructor and Destructor              *
+\******************************************************/
+
+/*
+ * BoardPool
+ * purpose: Initialize an empty pool with a slot for every first move
+ * parameters: n/a
+ * returns: n/a
+ * note: start must be called for the pool to be filled
+ */
+BoardPool::BoardPool()
+{
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff];
+        Slot empty = {false, false, vector<Pos>()};
+        slots[diff].assign(rows * cols, empty);
+
+        /* fill the cells closest to the middle first */
+        vector<pair<int, int> > byDistance;
+        for (int cell = 0; cell < rows * cols; ++cell) {
+            int rowDist = (2 * (cell / cols)) - (rows - 1);
+            int colDist = (2 * (cell % cols)) - (cols - 1);
+            byDistance.push_back(make_pair((rowDist * rowDist) + (colDist * colDist), cell));
+        }
+        sort(byDistance.begin(), byDistance.end());
+        for (size_t i = 0; i < byDistance.size(); ++i) {
+            fillOrder[diff].push_back(byDistance[i].second);
+        }
+    }
+
+    random_device rd;
+    seed = rd();
+    stopped = false;
+    priority = -1;
+    current = NULL;
+}
+
+/*
+ * ~BoardPool
+ * purpose: Stop the background thread
+ * parameters: n/a
+ * returns: n/a
+ */
+BoardPool::~BoardPool()
+{
+    stop();
+}
+
+
+/******************************************************\
+ *                   Run Functions                     *
+\******************************************************/
+
+/*
+ * start
+ * purpose: Start filling the pool on a background thread
+ * parameters: n/a
+ * returns: n/a
+ */
+void BoardPool::start()
+{
+    producer = thread(&BoardPool::produce, this);
+}
+
+/*
+ * stop
+ * purpose: Cancel the board being dealt and wait for the background thread
+ *          to finish
+ * parameters: n/a
+ * returns: n/a
+ */
+void BoardPool::stop()
+{
+    {
+        lock_guard<mutex> guard(poolLock);
+        stopped = true;
+        if (current != NULL) {
+            current->cancel();
+        }
+    }
+    slotTaken.notify_all();
+    if (producer.joinable()) {
+        producer.join();
+    }
+}
+
+/*
+ * setPriority
+ * purpose: Fill the given difficulty's slots before the others
+ * parameters:
+ *      int difficulty : The difficulty being played
+ * returns: n/a
+ */
+void BoardPool::setPriority(int difficulty)
+{
+    lock_guard<mutex> guard(poolLock);
+    priority = difficulty;
+}
+
+/*
+ * take
+ * purpose: Take the ready board for the given board size and first move
+ * parameters:
+ *                 int rows : Number of rows on the board
+ *                 int cols : Number of columns on the board
+ *                int mines : Number of mines on the board
+ *            Pos firstMove : The cell of the first move
+ *      vector<Pos> &layout : Filled with the mine locations if a board was
+ *                            ready
+ * returns: True if a board was ready, false if the board has to be dealt
+ *          by the caller (the size isn't a difficulty or the slot is empty)
+ * effects: The slot is emptied and will be filled again in the background
+ */
+bool BoardPool::take(int rows, int cols, int mines, Pos firstMove, vector<Pos> &layout)
+{
+    int diff = findDifficulty(rows, cols, mines);
+    if (diff < 0) {
+        return false;
+    }
+
+    /* empty the slot and wake the background thread to fill it again */
+    lock_guard<mutex> guard(poolLock);
+    Slot &slot = slots[diff][(firstMove.first * cols) + firstMove.second];
+    if (not slot.ready) {
+        return false;
+    }
+    layout.swap(slot.mines);
+    slot.ready = false;
+    slotTaken.notify_one();
+    return true;
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * produce
+ * purpose: Deal boards for the empty slots until the pool is stopped,
+ *          waiting whenever every slot is full
+ * parameters: n/a
+ * returns: n/a
+ * note: Runs on the background thread. The lock is released while dealing.
+ */
+void BoardPool::produce()
+{
+    unique_lock<mutex> lock(poolLock);
+    while (not stopped) {
+
+        /* wait until a slot needs a board */
+        int diff, cell;
+        if (not nextSlot(diff, cell)) {
+            slotTaken.wait(lock);
+            continue;
+        }
+
+        /* deal the board without holding the lock */
+        int cols = DIFF_COLS[diff];
+        Pos first = make_pair(cell / cols, cell % cols);
+        Generator generator;
+        generator.setWorkers(POOL_WORKERS);
+        current = &generator;
+        unsigned boardSeed = seed++;
+        lock.unlock();
+        vector<Pos> mines = generator.generate(DIFF_ROWS[diff], cols, DIFF_BOMBS[diff], first, boardSeed);
+        lock.lock();
+        current = NULL;
+
+        /* fill the slot (or skip it if no board could be found) */
+        if (not stopped) {
+            slots[diff][cell].mines = mines;
+            slots[diff][cell].ready = not mines.empty();
+            slots[diff][cell].failed = mines.empty();
+        }
+    }
+}
+
+/*
+ * nextSlot
+ * purpose: Find the next empty slot to fill
+ * parameters:
+ *      int &difficulty : Set to the difficulty of the slot
+ *            int &cell : Set to the first move of the slot (row major)
+ * returns: True if a slot is empty, false if the pool is full
+ * note: The caller must hold the lock
+ */
+bool BoardPool::nextSlot(int &difficulty, int &cell)
+{
+    /* check the difficulty being played, then the others in order */
+    for (int i = -1; i < NUM_DIFFS; ++i) {
+        int diff = (i < 0) ? priority : i;
+        if (diff < 0) {
+            continue;
+        }
+        for (size_t j = 0; j < fillOrder[diff].size(); ++j) {
+            Slot &slot = slots[diff][fillOrder[diff][j]];
+            if ((not slot.ready) and (not slot.failed)) {
+                difficulty = diff;
+                cell = fillOrder[diff][j];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * findDifficulty
+ * purpose: Find the difficulty with the given board size
+ * parameters:
+ *       int rows : Number of rows on the board
+ *       int cols : Number of columns on the board
+ *      int mines : Number of mines on the board
+ * returns: The difficulty, or -1 if no difficulty has that size
+ */
+int BoardPool::findDifficulty(int rows, int cols, int mines)
+{
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        if ((DIFF_ROWS[diff] == rows) and (DIFF_COLS[diff] == cols) and (DIFF_BOMBS[diff] == mines)) {
+            return diff;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,1246 @@
+/*
+ * Project: minesweeper
+ * Name: BoardRenderer.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the BoardRenderer class. The lines and the
+ *          hidden cells are drawn once into a background texture. On top of
+ *          it every cell owns two quads (two triangles each): the cell's
+ *          color, sampled from a white texel of the atlas, and its number,
+ *          flag or mine image. Hidden cells leave their quads empty so the
+ *          background shows through. The images and numbers are packed into
+ *          the atlas at the size they are drawn on screen, so they are drawn
+ *          pixel for pixel at any zoom (during a zoom the atlas is only
+ *          rebuilt when the size drifts too far, and again once the zoom
+ *          stops, from images decoded once). The cells' vertices are split
+ *          into tiles of TILE_SIZE x TILE_SIZE cells, and only the tiles in
+ *          view have vertices (and a background). Each update only rebuilds the
+ *          tiles in view with a cell the snapshot lists as changed, on a
+ *          pool of threads that each build a tile into a spare buffer from a
+ *          copy of its cells. The frame doesn't wait for them: a tile keeps
+ *          drawing its last vertices until its new ones are swapped in by a
+ *          later update, so no frame draws a half built tile. The changes
+ *          are applied in the order the board made them (an opening spreads
+ *          out from the click), and the marked tiles handed to the workers,
+ *          until the frame's REVEAL_BUDGET runs out, and the rest are left
+ *          for the next frames, so a huge opening plays out as a wave
+ *          instead of a hitch.
+ *          A frame costs the same on any size board. Every block of
+ *          LOD_BLOCK x LOD_BLOCK cells keeps a count of its hidden, flagged,
+ *          shown and mine cells, kept current from the same changes. Once
+ *          cells are smaller than LOD_CELL_PIXELS on screen the blocks in
+ *          view are drawn as one quad each, in the mix of their cells'
+ *          colors, instead of the cells and background.
+ *          The shader path instead writes a changed cell as one texel, uploads
+ *          the rectangle of texels that changed, and draws one quad whose
+ *          fragment shader finds the cell under each pixel and draws it (its
+ *          cost doesn't depend on the zoom, so it never draws blocks).
+ */
+
+#include "../Files_h/BoardRenderer.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/SnapshotBuffer.h"
+#include "../Files_h/Game_Constants.h"
+#include "../Files_h/TextureAtlas.h"
+#include "SFML/Graphics.hpp"
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cmath>
+#include <algorithm>
+
+/* vertices per quad (two triangles) and per cell (the cell and its image) */
+static const int QUAD_VERTICES = 6;
+static const int CELL_VERTICES = 2 * QUAD_VERTICES;
+
+/* cells across and down a tile of vertices */
+static const int TILE_SIZE = 64;
+
+/* time a frame may spend catching up on changed cells and handing their
+   tiles to the workers (the rest wait for the next frame), and how many
+   cells are applied between checks of it */
+static const Time REVEAL_BUDGET = milliseconds(4);
+static const int BUDGET_CHECK = 64;
+
+/* cells across and down a block, and the size on screen (in pixels) below
+   which a cell is drawn as part of its block */
+static const int LOD_BLOCK = 8;
+static const float LOD_CELL_PIXELS = 4;
+
+/* how far the zoom may drift from the size the atlas was drawn at before it
+   is drawn again in the middle of a zoom (it is always drawn again once the
+   zoom stops) */
+static const float ATLAS_RESCALE = 1.25f;
+
+/* color a flagged cell adds to its block */
+static const Color LOD_FLAG_COLOR = Color(220, 40, 40);
+
+/* the images in the atlas */
+static const int FLAG_IMAGE = 0;
+static const int WON_IMAGE  = 1;
+static const int LOST_IMAGE = 2;
+
+/* what a cell's texel holds: its number (red), whether it is hidden, shown
+   or a shown mine (green), and whether it is flagged (blue) */
+static const Uint8 TEXEL_HIDDEN = 0;
+static const Uint8 TEXEL_SHOWN  = 1;
+static const Uint8 TEXEL_MINE   = 2;
+static const Uint8 TEXEL_FLAG   = 255;
+
+/* images the shader can draw in a cell: the numbers 1 to 8, then the flag and
+   the mine */
+static const int NUM_ICONS = 10;
+static const int FLAG_ICON = 8;
+static const int MINE_ICON = 9;
+
+/* draws the grid from the cells' texels (texture coordinates are pixels from
+   the top left of the grid) */
+static const string GRID_SHADER =
+    "uniform sampler2D cells;\n"
+    "uniform sampler2D atlas;\n"
+    "uniform vec2 gridSize;\n"
+    "uniform vec2 atlasSize;\n"
+    "uniform float cellSize;\n"
+    "uniform float thickness;\n"
+    "uniform vec4 hiddenColor;\n"
+    "uniform vec4 shownColor;\n"
+    "uniform vec4 mineColor;\n"
+    "uniform vec4 lineColor;\n"
+    "uniform vec4 iconRects[10];\n"
+    "uniform vec4 iconAreas[10];\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 pos = gl_TexCoord[0].xy;\n"
+    "    vec2 cell = floor(pos / cellSize);\n"
+    "    vec2 local = pos - (cell * cellSize);\n"
+    "    bool outside = any(lessThan(cell, vec2(0.0))) || any(greaterThanEqual(cell, gridSize));\n"
+    "    bool line = outside\n"
+    "        || ((cell.x > 0.0) && (local.x < thickness)) || ((cell.y > 0.0) && (local.y < thickness))\n"
+    "        || ((cell.x < gridSize.x - 1.0) && (local.x > cellSize - thickness))\n"
+    "        || ((cell.y < gridSize.y - 1.0) && (local.y > cellSize - thickness));\n"
+    "    if (line) {\n"
+    "        gl_FragColor = lineColor;\n"
+    "        return;\n"
+    "    }\n"
+    "    vec4 texel = floor((texture2D(cells, (cell + 0.5) / gridSize) * 255.0) + 0.5);\n"
+    "    vec4 color = hiddenColor;\n"
+    "    int icon = -1;\n"
+    "    if (texel.g == 1.0) {\n"
+    "        color = shownColor;\n"
+    "        icon = int(texel.r) - 1;\n"
+    "    } else if (texel.g == 2.0) {\n"
+    "        color = mineColor;\n"
+    "        icon = 9;\n"
+    "    } else if (texel.b == 255.0) {\n"
+    "        icon = 8;\n"
+    "    }\n"
+    "    if (icon >= 0) {\n"
+    "        vec4 area = iconAreas[icon];\n"
+    "        vec2 inside = local - area.xy;\n"
+    "        if (all(greaterThanEqual(inside, vec2(0.0))) && all(lessThan(inside, area.zw))) {\n"
+    "            vec2 texel = iconRects[icon].xy + (inside * iconRects[icon].zw / area.zw);\n"
+    "            vec4 image = texture2D(atlas, texel / atlasSize);\n"
+    "            color.rgb = mix(color.rgb, image.rgb, image.a);\n"
+    "        }\n"
+    "    }\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+/* cell states that aren't a revealed value (those are MINE and 0 to 8), as
+   the snapshots hold them */
+static const int HIDDEN_STATE = HIDDEN;
+static const int FLAG_STATE   = FLAGGED;
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * BoardRenderer
+ * purpose: Initialize a renderer with no board
+ * parameters: n/a
+ * returns: n/a
+ */
+BoardRenderer::BoardRenderer()
+{
+    snapshot = NULL;
+    lastSequence = 0;
+    numRows = numCols = 0;
+    cellScaler = thickness = 0;
+    imageScale = 1;
+    mineWon = false;
+    digitFont = NULL;
+    digitSize = 0;
+    atlasStale = true;
+    whiteId = -1;
+    for (int i = 0; i < 3; ++i) {
+        imageIds[i] = -1;
+        imageLoaded[i] = false;
+    }
+    for (int i = 0; i < 8; ++i) {
+        digitIds[i] = -1;
+    }
+    tileCols = 0;
+    tilesBuilding = 0;
+    tilesLeft = false;
+    waiting = false;
+    builders.start(0);
+    blockVertices.setPrimitiveType(Triangles);
+    statesStale = shownStale = true;
+    blockCols = 0;
+    lodShown = false;
+    backgroundStale = true;
+    useShader = false;
+    boardQuad.setPrimitiveType(Triangles);
+    boardQuad.resize(QUAD_VERTICES);
+    iconQuads.setPrimitiveType(Triangles);
+    iconQuads.resize(NUM_ICONS * QUAD_VERTICES);
+    pixelScale = atlasScale = 1;
+}
+
+
+/******************************************************\
+ *                   Initializers                      *
+\******************************************************/
+
+/*
+ * setBoard
+ * purpose: Set the size of the board to draw and where to draw it
+ * parameters:
+ *                   int rows : Number of rows on the board
+ *                   int cols : Number of columns on the board
+ *             float cellSize : Width and height of a cell
+ *            Vector2f origin : Top left corner of the grid
+ *        float lineThickness : Thickness of the lines around each cell
+ * returns: n/a
+ * note: The cells themselves come from the snapshots given to update
+ */
+void BoardRenderer::setBoard(int rows, int cols, float cellSize, Vector2f origin, float lineThickness)
+{
+    finishBuilds();
+    numRows = rows;
+    numCols = cols;
+    atlasStale = atlasStale or (cellSize != cellScaler);
+    cellScaler = cellSize;
+    topLeft = origin;
+    thickness = lineThickness;
+    invalidate();
+}
+
+/*
+ * setCellColors
+ * purpose: Set the colors of the hidden and revealed cells and the lines
+ * parameters:
+ *      Color hidden : Color of a hidden cell
+ *       Color shown : Color of a revealed cell
+ *        Color line : Color of the lines around the cells
+ * returns: n/a
+ */
+void BoardRenderer::setCellColors(Color hidden, Color shown, Color line)
+{
+    finishBuilds();
+    hiddenColor = hidden;
+    shownColor = shown;
+    lineColor = line;
+    invalidate();
+}
+
+/*
+ * setDigits
+ * purpose: Set the font, size and colors of the numbers
+ * parameters:
+ *      const Text *digits : The texts of the numbers 1 to 8
+ * returns: n/a
+ */
+void BoardRenderer::setDigits(const Text *digitTexts)
+{
+    digitFont = digitTexts[0].getFont();
+    digitSize = digitTexts[0].getCharacterSize();
+    for (int i = 0; i < 8; ++i) {
+        digitColors[i] = digitTexts[i].getFillColor();
+    }
+    atlasStale = true;
+    invalidate();
+}
+
+/*
+ * setImages
+ * purpose: Set the images drawn on flagged cells and revealed mines
+ * parameters:
+ *      const string &flag : File of the flag image
+ *       const string &won : File of the mine image once the game is won
+ *      const string &lost : File of the mine image once the game is lost
+ *        float imageScale : Size of the images relative to a cell
+ * returns: n/a
+ * note: The files are read here, once (a missing file is drawn as nothing)
+ */
+void BoardRenderer::setImages(const string &flag, const string &won, const string &lost, float scale)
+{
+    string files[3];
+    files[FLAG_IMAGE] = flag;
+    files[WON_IMAGE] = won;
+    files[LOST_IMAGE] = lost;
+    for (int i = 0; i < 3; ++i) {
+        imageLoaded[i] = (not files[i].empty()) and images[i].loadFromFile(files[i]);
+    }
+    imageScale = scale;
+    atlasStale = true;
+    invalidate();
+}
+
+/*
+ * setMine
+ * purpose: Set the image and cell color of revealed mines
+ * parameters:
+ *        bool won : Whether the game was won (which image to draw)
+ *      Color fill : Color of a revealed mine's cell
+ * returns: n/a
+ */
+void BoardRenderer::setMine(bool won, Color fill)
+{
+    finishBuilds();
+    mineWon = won;
+    mineColor = fill;
+    if (not atlasStale) {
+        cacheIcons();
+    }
+    invalidate();
+}
+
+/*
+ * setShader
+ * purpose: Choose whether the grid is drawn by the shader (one quad) or from
+ *          vertices (two quads per cell)
+ * parameters:
+ *      bool enabled : Whether to draw with the shader
+ * returns: True if the shader is used, false if it was disabled or shaders
+ *          aren't available (the vertices are used instead)
+ */
+bool BoardRenderer::setShader(bool enabled)
+{
+    useShader = enabled and Shader::isAvailable() and shader.loadFromMemory(GRID_SHADER, Shader::Fragment);
+    invalidate();
+    return useShader;
+}
+
+/*
+ * setWaiting
+ * purpose: Choose whether update spreads its work over the next frames or
+ *          finishes it before returning
+ * parameters:
+ *      bool wait : True to finish every change and tile in each update (for
+ *                  frames drawn one at a time off screen)
+ * returns: n/a
+ */
+void BoardRenderer::setWaiting(bool wait)
+{
+    waiting = wait;
+}
+
+
+/******************************************************\
+ *                  Draw Functions                     *
+\******************************************************/
+
+/*
+ * update
+ * purpose: Redraw the cells the snapshot lists as changed (or everything in
+ *          view if the view changed)
+ * parameters:
+ *          const RenderTarget &target : The window (or texture) that will
+ *                                       be drawn on, with the view it will
+ *                                       be drawn with already set
+ *      const BoardSnapshot &boardShot : The board to draw (see
+ *                                       SnapshotBuffer), kept until the
+ *                                       next update
+ * returns: n/a
+ * note: Once a zoom stops (or drifts past ATLAS_RESCALE) the atlas is
+ *       rebuilt at the new size along with every tile in view, in between
+ *       the atlas is drawn scaled. A change of the cells in view builds the
+ *       tiles that came into view and frees the ones that left it.
+ */
+void BoardRenderer::update(const RenderTarget &target, const BoardSnapshot &boardShot)
+{
+    snapshot = &boardShot;
+
+    /* the area in view and how many pixels a unit of it is drawn as */
+    const View &view = target.getView();
+    Vector2f viewSize = view.getSize();
+    FloatRect area(view.getCenter().x - (viewSize.x / 2), view.getCenter().y - (viewSize.y / 2), viewSize.x,
+                   viewSize.y);
+    float scale = target.getViewport(view).width / viewSize.x;
+    bool settled = (scale == pixelScale);
+    float drift = max(scale / atlasScale, atlasScale / scale);
+    if ((scale != atlasScale) and ((settled) or (drift > ATLAS_RESCALE))) {
+        atlasStale = true;
+    }
+    pixelScale = scale;
+    if (atlasStale) {
+        buildAtlas();
+    }
+
+    /* catch up on the cells that changed, in order, for as long as the
+       budget allows (all of them at once if the board or the looks of the
+       cells changed) */
+    if (snapshot->sequence != lastSequence) {
+        pending.insert(pending.end(), snapshot->changed.begin(), snapshot->changed.end());
+        lastSequence = snapshot->sequence;
+    }
+    if (statesStale) {
+        scanBoard();
+    }
+    Clock budget;
+    for (int applied = 1; not pending.empty(); ++applied) {
+        setState(pending.front().first, pending.front().second,
+                 cellState(pending.front().first, pending.front().second));
+        pending.pop_front();
+        if ((not waiting) and (applied % BUDGET_CHECK == 0) and (budget.getElapsedTime() >= REVEAL_BUDGET)) {
+            break;
+        }
+    }
+
+    /* find what's in view, drawing blocks if the cells got too small to draw
+       one by one */
+    IntRect cells = visibleCells(area);
+    bool lod = (not useShader) and (cellScaler * pixelScale < LOD_CELL_PIXELS);
+    if ((cells != shownCells) or (lod != lodShown)) {
+        shownCells = cells;
+        lodShown = lod;
+        redrawShown();
+    }
+    if (shownStale) {
+        drawShown();
+    }
+
+    /* swap in the tiles the workers finished and hand them the marked ones
+       (only waiting for them when drawing off screen) */
+    collectTiles();
+    if ((not useShader) and (not lodShown)) {
+        buildTiles(budget);
+        if (waiting) {
+            finishBuilds();
+        }
+    }
+    if ((backgroundStale) and (not useShader) and (not lodShown)) {
+        drawBackground();
+    }
+    if (useShader) {
+        uploadTexels();
+    }
+}
+
+/*
+ * revealing
+ * purpose: Returns whether some changed cells are still waiting to be drawn
+ * parameters: n/a
+ * returns: True if the grid should be updated and drawn again next frame
+ *          (cells or tiles are waiting, or tiles are being built)
+ */
+bool BoardRenderer::revealing() const
+{
+    return (not pending.empty()) or (tilesLeft) or (tilesBuilding > 0);
+}
+
+/*
+ * draw
+ * purpose: Draw the grid
+ * parameters:
+ *      RenderTarget &target : The window (or texture) to draw on
+ * returns: n/a
+ * note: A draw call for the background and one per tile in view (a few at
+ *       most) no matter the size of the board, or one with the shader or
+ *       when drawing blocks. update must be called first with the same view.
+ */
+void BoardRenderer::draw(RenderTarget &target)
+{
+    if (useShader) {
+        target.draw(boardQuad, RenderStates(&shader));
+    } else if (lodShown) {
+        target.draw(blockVertices, RenderStates(&atlas.getTexture()));
+    } else {
+        target.draw(backgroundSprite);
+        for (int row = shownTiles.top; row < shownTiles.top + shownTiles.height; ++row) {
+            for (int col = shownTiles.left; col < shownTiles.left + shownTiles.width; ++col) {
+                const vector<Vertex> &tile = tiles[(row * tileCols) + col].vertices;
+                if (not tile.empty()) {
+                    target.draw(&tile[0], tile.size(), Triangles, RenderStates(&atlas.getTexture()));
+                }
+            }
+        }
+    }
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * buildAtlas
+ * purpose: Pack the images, scaled to the size they are drawn, and the
+ *          numbers, rasterized at the size they are drawn, into the atlas
+ * parameters: n/a
+ * returns: n/a
+ * note: Missing images and numbers are left out and drawn as nothing. If
+ *       they are too big to pack (zoomed far in), they are all left out.
+ */
+void BoardRenderer::buildAtlas()
+{
+    finishBuilds();
+    atlasScale = pixelScale;
+    atlas.clear();
+    whiteId = atlas.addColor(Color::White);
+
+    /* the images, at their size on screen */
+    unsigned size = round(cellScaler * imageScale * atlasScale);
+    for (int i = 0; i < 3; ++i) {
+        imageIds[i] = imageLoaded[i] ? atlas.addScaled(images[i], size, size) : -1;
+    }
+
+    /* the numbers, copied out of the font's glyph texture in their colors */
+    for (int i = 0; i < 8; ++i) {
+        digitIds[i] = -1;
+    }
+    if (digitFont != NULL) {
+        unsigned sizeShown = max(1.0f, round(digitSize * atlasScale));
+        for (int i = 0; i < 8; ++i) {
+            digitBounds[i] = digitFont->getGlyph('1' + i, sizeShown, false).bounds;
+        }
+        Image glyphs = digitFont->getTexture(sizeShown).copyToImage();
+        for (int i = 0; i < 8; ++i) {
+            IntRect rect = digitFont->getGlyph('1' + i, sizeShown, false).textureRect;
+            Image digit;
+            digit.create(rect.width, rect.height, Color::Transparent);
+            for (int y = 0; y < rect.height; ++y) {
+                for (int x = 0; x < rect.width; ++x) {
+                    Color pixel = digitColors[i];
+                    pixel.a = (glyphs.getPixel(rect.left + x, rect.top + y).a * pixel.a) / 255;
+                    digit.setPixel(x, y, pixel);
+                }
+            }
+            digitIds[i] = atlas.add(digit);
+        }
+    }
+
+    /* too big for one texture: draw the cells without images or numbers
+       rather than from places in the texture that were never packed */
+    if (not atlas.build()) {
+        atlas.clear();
+        whiteId = atlas.addColor(Color::White);
+        for (int i = 0; i < 3; ++i) {
+            imageIds[i] = -1;
+        }
+        for (int i = 0; i < 8; ++i) {
+            digitIds[i] = -1;
+        }
+        atlas.build();
+    }
+    atlasStale = false;
+    cacheIcons();
+    shownStale = backgroundStale = true;
+    if (useShader) {
+        setUniforms();
+    }
+}
+
+/*
+ * cellState
+ * purpose: Find what a cell should be drawn as
+ * parameters:
+ *      int row : The row of the cell
+ *      int col : The column of the cell
+ * returns: The revealed value (MINE or 0 to 8), HIDDEN_STATE or FLAG_STATE
+ */
+int BoardRenderer::cellState(int row, int col)
+{
+    return snapshot->cells[(row * numCols) + col];
+}
+
+/*
+ * scanBoard
+ * purpose: Check the state of every cell, count the states in every block
+ *          and empty every tile
+ * parameters: n/a
+ * returns: n/a
+ * note: Only needed when the board or the looks of the cells change, every
+ *       other update only checks the cells the snapshot lists as changed
+ */
+void BoardRenderer::scanBoard()
+{
+    finishBuilds();
+    blockCols = (numCols + LOD_BLOCK - 1) / LOD_BLOCK;
+    int blockRows = (numRows + LOD_BLOCK - 1) / LOD_BLOCK;
+    BlockSummary empty = {0, 0, 0, 0};
+    blocks.assign(blockRows * blockCols, empty);
+    tileCols = (numCols + TILE_SIZE - 1) / TILE_SIZE;
+    int tileRows = (numRows + TILE_SIZE - 1) / TILE_SIZE;
+    Tile emptyTile = {vector<Vertex>(), vector<Vertex>(), vector<int>(), false, false};
+    tiles.assign(tileRows * tileCols, emptyTile);
+    shownTiles = shownCells = IntRect();
+    states.resize(numRows * numCols);
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            int state = cellState(row, col);
+            states[(row * numCols) + col] = state;
+            countState(blocks[((row / LOD_BLOCK) * blockCols) + (col / LOD_BLOCK)], state, 1);
+            if (useShader) {
+                writeTexel(row, col, state);
+            }
+        }
+    }
+    pending.clear();
+    statesStale = false;
+    shownStale = true;
+}
+
+/*
+ * setState
+ * purpose: Update a cell that the snapshot listed as changed, redrawing its
+ *          block or marking its tile to be built again if it is in view
+ * parameters:
+ *        int row : The row of the cell
+ *        int col : The column of the cell
+ *      int state : What the cell is drawn as now (see cellState)
+ * returns: n/a
+ */
+void BoardRenderer::setState(int row, int col, int state)
+{
+    int &known = states[(row * numCols) + col];
+    if (state == known) {
+        return;
+    }
+    int blockRow = row / LOD_BLOCK, blockCol = col / LOD_BLOCK;
+    BlockSummary &block = blocks[(blockRow * blockCols) + blockCol];
+    countState(block, known, -1);
+    countState(block, state, 1);
+    known = state;
+
+    /* redraw it now unless everything in view is redrawn anyway */
+    if (useShader) {
+        writeTexel(row, col, state);
+    } else if (shownStale) {
+        return;
+    } else if ((lodShown) and (shownBlocks.contains(blockCol, blockRow))) {
+        writeBlock(blockRow, blockCol);
+    } else if ((not lodShown) and (shownTiles.contains(col / TILE_SIZE, row / TILE_SIZE))) {
+        tiles[((row / TILE_SIZE) * tileCols) + (col / TILE_SIZE)].dirty = true;
+    }
+}
+
+/*
+ * countState
+ * purpose: Add to or take from a block's count of cells in a state
+ * parameters:
+ *      BlockSummary &block : The block
+ *                int state : The state (see cellState)
+ *               int amount : 1 to add a cell, -1 to take one away
+ * returns: n/a
+ */
+void BoardRenderer::countState(BlockSummary &block, int state, int amount)
+{
+    if (state == FLAG_STATE) {
+        block.flagged += amount;
+    } else if (state == HIDDEN_STATE) {
+        block.hidden += amount;
+    } else if (state == MINE) {
+        block.mines += amount;
+    } else {
+        block.shown += amount;
+    }
+}
+
+/*
+ * writeCell
+ * purpose: Write a cell's quads
+ * parameters:
+ *      Vertex *cell : The cell's first vertex
+ *           int row : The row of the cell
+ *           int col : The column of the cell
+ *         int state : What the cell is drawn as (see cellState)
+ * returns: n/a
+ * note: Only reads the renderer, so tiles can be written on several threads
+ *       at once
+ */
+void BoardRenderer::writeCell(Vertex *cell, int row, int col, int state) const
+{
+    float xPos = topLeft.x + (cellScaler * col);
+    float yPos = topLeft.y + (cellScaler * row);
+
+    /* the cell (hidden cells are already drawn in the background) */
+    if (state >= MINE) {
+        Color fill = (state == MINE) ? mineColor : shownColor;
+        setQuad(cell, cellArea(row, col), atlas.getRect(whiteId), fill);
+    } else {
+        clearQuad(cell);
+    }
+
+    /* the image or number, copied from its quad moved to the cell's whole
+       pixel corner */
+    int icon = iconIndex(state);
+    if (icon < 0) {
+        clearQuad(cell + QUAD_VERTICES);
+        return;
+    }
+    Vector2f corner(round(xPos * atlasScale) / atlasScale, round(yPos * atlasScale) / atlasScale);
+    for (int i = 0; i < QUAD_VERTICES; ++i) {
+        Vertex vertex = iconQuads[(icon * QUAD_VERTICES) + i];
+        vertex.position += corner;
+        cell[QUAD_VERTICES + i] = vertex;
+    }
+}
+
+/*
+ * cellArea
+ * purpose: Find the area of a cell, leaving room for the lines between it
+ *          and its neighbors
+ * parameters:
+ *      int row : The row of the cell
+ *      int col : The column of the cell
+ * returns: The area inside the cell's lines
+ */
+FloatRect BoardRenderer::cellArea(int row, int col) const
+{
+    float left   = (col == 0) ? 0 : thickness;
+    float top    = (row == 0) ? 0 : thickness;
+    float right  = (col == numCols - 1) ? 0 : thickness;
+    float bottom = (row == numRows - 1) ? 0 : thickness;
+    return FloatRect(topLeft.x + (cellScaler * col) + left, topLeft.y + (cellScaler * row) + top,
+                     cellScaler - left - right, cellScaler - top - bottom);
+}
+
+/*
+ * writeBlock
+ * purpose: Write a block's quad, covering its cells, in the mix of its cells'
+ *          colors
+ * parameters:
+ *      int blockRow : The row of the block
+ *      int blockCol : The column of the block
+ * returns: n/a
+ */
+void BoardRenderer::writeBlock(int blockRow, int blockCol)
+{
+    size_t block = ((blockRow - shownBlocks.top) * shownBlocks.width) + (blockCol - shownBlocks.left);
+    int row = blockRow * LOD_BLOCK, col = blockCol * LOD_BLOCK;
+    FloatRect area(topLeft.x + (cellScaler * col), topLeft.y + (cellScaler * row),
+                   cellScaler * min(LOD_BLOCK, numCols - col), cellScaler * min(LOD_BLOCK, numRows - row));
+    Color fill = blockColor(blocks[(blockRow * blockCols) + blockCol]);
+    setQuad(&blockVertices[block * QUAD_VERTICES], area, atlas.getRect(whiteId), fill);
+}
+
+/*
+ * blockColor
+ * purpose: Find the average color of a block's cells
+ * parameters:
+ *      const BlockSummary &block : The block's count of cells in each state
+ * returns: The colors of its hidden, flagged, shown and mine cells, weighted
+ *          by how many of each it has
+ */
+Color BoardRenderer::blockColor(const BlockSummary &block)
+{
+    Color colors[4] = {hiddenColor, LOD_FLAG_COLOR, shownColor, mineColor};
+    int counts[4] = {block.hidden, block.flagged, block.shown, block.mines};
+    int total = 0, red = 0, green = 0, blue = 0;
+    for (int i = 0; i < 4; ++i) {
+        total += counts[i];
+        red += colors[i].r * counts[i];
+        green += colors[i].g * counts[i];
+        blue += colors[i].b * counts[i];
+    }
+    if (total == 0) {
+        return hiddenColor;
+    }
+    return Color(red / total, green / total, blue / total);
+}
+
+/*
+ * iconIndex
+ * purpose: Find the image or number drawn on a cell
+ * parameters:
+ *      int state : What the cell is drawn as (see cellState)
+ * returns: The index of its quad (the numbers 1 to 8, then FLAG_ICON and
+ *          MINE_ICON), or -1 if nothing is drawn on the cell
+ */
+int BoardRenderer::iconIndex(int state) const
+{
+    if (state == FLAG_STATE) {
+        return FLAG_ICON;
+    } else if (state == MINE) {
+        return MINE_ICON;
+    } else if (state > 0) {
+        return state - 1;
+    }
+    return -1;
+}
+
+/*
+ * cacheIcons
+ * purpose: Write the quad of every image and number as drawn in a cell whose
+ *          top left corner is at the origin, centered on whole pixels of the
+ *          screen (on the glyph's bounds for numbers), so drawing one is a
+ *          copy
+ * parameters: n/a
+ * returns: n/a
+ * note: Images and numbers that aren't in the atlas get an empty quad
+ */
+void BoardRenderer::cacheIcons()
+{
+    iconQuads.resize(NUM_ICONS * QUAD_VERTICES);
+    for (int icon = 0; icon < NUM_ICONS; ++icon) {
+        int id = digitIds[min(icon, 7)];
+        if (icon == FLAG_ICON) {
+            id = imageIds[FLAG_IMAGE];
+        } else if (icon == MINE_ICON) {
+            id = imageIds[mineWon ? WON_IMAGE : LOST_IMAGE];
+        }
+        if (id < 0) {
+            for (int i = 0; i < QUAD_VERTICES; ++i) {
+                iconQuads[(icon * QUAD_VERTICES) + i] = Vertex();
+            }
+            continue;
+        }
+        FloatRect texture = atlas.getRect(id);
+        FloatRect centered = (icon < FLAG_ICON) ? digitBounds[icon] : texture;
+        float cellPixels = cellScaler * atlasScale;
+        FloatRect area(round((cellPixels - centered.width) / 2) / atlasScale,
+                       round((cellPixels - centered.height) / 2) / atlasScale, texture.width / atlasScale,
+                       texture.height / atlasScale);
+        setQuad(&iconQuads[icon * QUAD_VERTICES], area, texture, Color::White);
+    }
+}
+
+/*
+ * setQuad
+ * purpose: Write a rectangle as two triangles
+ * parameters:
+ *           Vertex *quad : The quad's first vertex
+ *         FloatRect area : Where the rectangle is drawn
+ *      FloatRect texture : The part of the texture drawn on it
+ *            Color color : Color the texture is multiplied by
+ * returns: n/a
+ */
+void BoardRenderer::setQuad(Vertex *quad, FloatRect area, FloatRect texture, Color color) const
+{
+    Vector2f corners[4] = {Vector2f(area.left, area.top), Vector2f(area.left + area.width, area.top),
+                           Vector2f(area.left + area.width, area.top + area.height),
+                           Vector2f(area.left, area.top + area.height)};
+    Vector2f coords[4] = {Vector2f(texture.left, texture.top), Vector2f(texture.left + texture.width, texture.top),
+                          Vector2f(texture.left + texture.width, texture.top + texture.height),
+                          Vector2f(texture.left, texture.top + texture.height)};
+    static const int ORDER[QUAD_VERTICES] = {0, 1, 2, 0, 2, 3};
+    for (int i = 0; i < QUAD_VERTICES; ++i) {
+        quad[i] = Vertex(corners[ORDER[i]], color, coords[ORDER[i]]);
+    }
+}
+
+/*
+ * clearQuad
+ * purpose: Empty a quad so it draws nothing
+ * parameters:
+ *      Vertex *quad : The quad's first vertex
+ * returns: n/a
+ */
+void BoardRenderer::clearQuad(Vertex *quad) const
+{
+    for (int i = 0; i < QUAD_VERTICES; ++i) {
+        quad[i] = Vertex();
+    }
+}
+
+/*
+ * drawBackground
+ * purpose: Draw the lines and the cells in view as hidden into the
+ *          background, at the size the atlas is drawn at
+ * parameters: n/a
+ * returns: n/a
+ */
+void BoardRenderer::drawBackground()
+{
+    backgroundStale = false;
+    FloatRect lines = linesArea(shownCells);
+    Vector2f corner(floor(lines.left * atlasScale), floor(lines.top * atlasScale));
+    unsigned width = ceil((lines.left + lines.width) * atlasScale) - corner.x;
+    unsigned height = ceil((lines.top + lines.height) * atlasScale) - corner.y;
+    if ((shownCells.width == 0) or (shownCells.height == 0) or (whiteId < 0)) {
+        backgroundSprite = Sprite();
+        return;
+    }
+    Vector2u size = background.getSize();
+    if ((size.x != width) or (size.y != height)) {
+        background.create(width, height);
+    }
+
+    /* the lines, with the hidden cells on top */
+    FloatRect white = atlas.getRect(whiteId);
+    VertexArray layer(Triangles, ((shownCells.width * shownCells.height) + 1) * QUAD_VERTICES);
+    setQuad(&layer[0], lines, white, lineColor);
+    size_t quad = QUAD_VERTICES;
+    for (int row = shownCells.top; row < shownCells.top + shownCells.height; ++row) {
+        for (int col = shownCells.left; col < shownCells.left + shownCells.width; ++col) {
+            setQuad(&layer[quad], cellArea(row, col), white, hiddenColor);
+            quad += QUAD_VERTICES;
+        }
+    }
+    RenderStates states(&atlas.getTexture());
+    states.transform.translate(-corner.x, -corner.y).scale(atlasScale, atlasScale);
+    background.clear(Color::Transparent);
+    background.draw(layer, states);
+    background.display();
+    backgroundSprite.setTexture(background.getTexture(), true);
+    backgroundSprite.setPosition(corner.x / atlasScale, corner.y / atlasScale);
+    backgroundSprite.setScale(1 / atlasScale, 1 / atlasScale);
+}
+
+/*
+ * linesArea
+ * purpose: Find the area of some of the cells including the lines around
+ *          their edges
+ * parameters:
+ *      IntRect cells : The cells (columns across, rows down)
+ * returns: The area
+ */
+FloatRect BoardRenderer::linesArea(IntRect cells)
+{
+    return FloatRect(topLeft.x + (cellScaler * cells.left) - thickness,
+                     topLeft.y + (cellScaler * cells.top) - thickness,
+                     (cellScaler * cells.width) + (2 * thickness), (cellScaler * cells.height) + (2 * thickness));
+}
+
+/*
+ * visibleCells
+ * purpose: Find the cells that are at least partly inside an area
+ * parameters:
+ *      FloatRect area : The area (usually the view)
+ * returns: The cells (columns across, rows down), empty if none are
+ */
+IntRect BoardRenderer::visibleCells(FloatRect area)
+{
+    int left   = max(0, (int)floor((area.left - topLeft.x) / cellScaler));
+    int top    = max(0, (int)floor((area.top - topLeft.y) / cellScaler));
+    int right  = min(numCols, (int)ceil((area.left + area.width - topLeft.x) / cellScaler));
+    int bottom = min(numRows, (int)ceil((area.top + area.height - topLeft.y) / cellScaler));
+    if ((right <= left) or (bottom <= top)) {
+        return IntRect();
+    }
+    return IntRect(left, top, right - left, bottom - top);
+}
+
+/*
+ * redrawShown
+ * purpose: Follow a change of the cells in view, or between drawing cells
+ *          and blocks: free the tiles that left the view, mark the ones that
+ *          came into view to be built, and give the blocks in view their
+ *          vertices
+ * parameters: n/a
+ * returns: n/a
+ * note: The shader keeps its texels (only its uniforms can have changed)
+ */
+void BoardRenderer::redrawShown()
+{
+    if (useShader) {
+        setUniforms();
+        return;
+    }
+    backgroundStale = true;
+
+    /* the tiles in view (none when drawing blocks) */
+    IntRect inView = lodShown ? IntRect() : cellGroups(shownCells, TILE_SIZE);
+    for (int row = shownTiles.top; row < shownTiles.top + shownTiles.height; ++row) {
+        for (int col = shownTiles.left; col < shownTiles.left + shownTiles.width; ++col) {
+            if (not inView.contains(col, row)) {
+                Tile &tile = tiles[(row * tileCols) + col];
+                vector<Vertex>().swap(tile.vertices);
+                if (not tile.inFlight) {
+                    vector<Vertex>().swap(tile.building);
+                }
+            }
+        }
+    }
+    for (int row = inView.top; row < inView.top + inView.height; ++row) {
+        for (int col = inView.left; col < inView.left + inView.width; ++col) {
+            if (not shownTiles.contains(col, row)) {
+                tiles[(row * tileCols) + col].dirty = true;
+            }
+        }
+    }
+    shownTiles = inView;
+
+    /* the blocks in view (none when drawing cells), all drawn again */
+    shownBlocks = lodShown ? cellGroups(shownCells, LOD_BLOCK) : IntRect();
+    blockVertices.resize(shownBlocks.width * shownBlocks.height * QUAD_VERTICES);
+    shownStale = shownStale or lodShown;
+}
+
+/*
+ * drawShown
+ * purpose: Draw every block in view again, or mark every tile in view to be
+ *          built again
+ * parameters: n/a
+ * returns: n/a
+ */
+void BoardRenderer::drawShown()
+{
+    shownStale = false;
+    for (int row = shownBlocks.top; row < shownBlocks.top + shownBlocks.height; ++row) {
+        for (int col = shownBlocks.left; col < shownBlocks.left + shownBlocks.width; ++col) {
+            writeBlock(row, col);
+        }
+    }
+    for (int row = shownTiles.top; row < shownTiles.top + shownTiles.height; ++row) {
+        for (int col = shownTiles.left; col < shownTiles.left + shownTiles.width; ++col) {
+            tiles[(row * tileCols) + col].dirty = true;
+        }
+    }
+}
+
+/*
+ * cellGroups
+ * purpose: Find the groups of cells (blocks or tiles) that some cells are in
+ * parameters:
+ *      IntRect cells : The cells (columns across, rows down)
+ *           int size : Cells across and down a group
+ * returns: The groups (columns across, rows down), empty if the cells are
+ */
+IntRect BoardRenderer::cellGroups(IntRect cells, int size)
+{
+    if ((cells.width == 0) or (cells.height == 0)) {
+        return IntRect();
+    }
+    int left = cells.left / size, top = cells.top / size;
+    int right = (cells.left + cells.width + size - 1) / size;
+    int bottom = (cells.top + cells.height + size - 1) / size;
+    return IntRect(left, top, right - left, bottom - top);
+}
+
+/*
+ * buildTiles
+ * purpose: Give the workers the marked tiles in view that aren't already
+ *          being built, until the frame's budget runs out
+ * parameters:
+ *      const Clock &budget : Time spent on the frame's changes so far
+ * returns: n/a
+ * note: Doesn't wait for the workers. At least one tile is handed out a
+ *       frame so the tiles keep up with a long wave. A tile marked again
+ *       while it is being built is given to them again once it is swapped
+ *       in.
+ */
+void BoardRenderer::buildTiles(const Clock &budget)
+{
+    tilesLeft = false;
+    bool handed = false;
+    for (int row = shownTiles.top; row < shownTiles.top + shownTiles.height; ++row) {
+        for (int col = shownTiles.left; col < shownTiles.left + shownTiles.width; ++col) {
+            int index = (row * tileCols) + col;
+            Tile &tile = tiles[index];
+            if ((not tile.dirty) or (tile.inFlight)) {
+                continue;
+            }
+            if ((handed) and (not waiting) and (budget.getElapsedTime() >= REVEAL_BUDGET)) {
+                tilesLeft = true;
+                return;
+            }
+            handed = true;
+
+            /* the worker gets its own copy of the tile's cells */
+            int top = row * TILE_SIZE, left = col * TILE_SIZE;
+            int width = min(TILE_SIZE, numCols - left), height = min(TILE_SIZE, numRows - top);
+            tile.cells.resize(width * height);
+            for (int r = 0; r < height; ++r) {
+                copy(states.begin() + ((top + r) * numCols) + left,
+                     states.begin() + ((top + r) * numCols) + left + width, tile.cells.begin() + (r * width));
+            }
+            tile.dirty = false;
+            tile.inFlight = true;
+            ++tilesBuilding;
+            builders.submit([this, index]() { buildTile(index); });
+        }
+    }
+}
+
+/*
+ * buildTile
+ * purpose: Write the vertices of every cell in a tile into its spare buffer
+ * parameters:
+ *      int index : The tile (row major)
+ * returns: n/a
+ * note: Runs on a worker thread. Only the tile's spare buffer is written,
+ *       from its copy of its cells, then the tile is listed as finished.
+ */
+void BoardRenderer::buildTile(int index)
+{
+    int top = (index / tileCols) * TILE_SIZE, left = (index % tileCols) * TILE_SIZE;
+    int width = min(TILE_SIZE, numCols - left), height = min(TILE_SIZE, numRows - top);
+    Tile &tile = tiles[index];
+    tile.building.resize(width * height * CELL_VERTICES);
+    for (int row = top; row < top + height; ++row) {
+        for (int col = left; col < left + width; ++col) {
+            size_t cell = ((row - top) * width) + (col - left);
+            writeCell(&tile.building[cell * CELL_VERTICES], row, col, tile.cells[cell]);
+        }
+    }
+
+    lock_guard<mutex> guard(finishedLock);
+    finished.push_back(index);
+}
+
+/*
+ * collectTiles
+ * purpose: Swap in the vertices of the tiles the workers finished
+ * parameters: n/a
+ * returns: n/a
+ * note: A finished tile that left the view is freed instead
+ */
+void BoardRenderer::collectTiles()
+{
+    vector<int> done;
+    {
+        lock_guard<mutex> guard(finishedLock);
+        done.swap(finished);
+    }
+    for (size_t i = 0; i < done.size(); ++i) {
+        Tile &tile = tiles[done[i]];
+        tile.inFlight = false;
+        --tilesBuilding;
+        if (shownTiles.contains(done[i] % tileCols, done[i] / tileCols)) {
+            tile.vertices.swap(tile.building);
+        } else {
+            vector<Vertex>().swap(tile.building);
+        }
+    }
+}
+
+/*
+ * finishBuilds
+ * purpose: Wait for the workers and swap in every tile they built
+ * parameters: n/a
+ * returns: n/a
+ * note: Called before changing anything the workers read (the board's
+ *       size, the tiles, the colors, the atlas and the icons)
+ */
+void BoardRenderer::finishBuilds()
+{
+    builders.wait();
+    collectTiles();
+}
+
+/*
+ * invalidate
+ * purpose: Mark the background (or the shader's quad) and every cell to be
+ *          checked and drawn again on the next update
+ * parameters: n/a
+ * returns: n/a
+ */
+void BoardRenderer::invalidate()
+{
+    statesStale = true;
+    shownCells = IntRect();
+    backgroundStale = true;
+    if ((not useShader) or (numRows * numCols == 0)) {
+        return;
+    }
+    FloatRect lines = linesArea(IntRect(0, 0, numCols, numRows));
+
+    /* one texel per cell, all of them uploaded on the next update */
+    Vector2u size = cellTexture.getSize();
+    if ((size.x != (unsigned)numCols) or (size.y != (unsigned)numRows)) {
+        cellTexture.create(numCols, numRows);
+    }
+    texels.assign(numRows * numCols * 4, 0);
+    changed = IntRect();
+    FloatRect local(-thickness, -thickness, lines.width, lines.height);
+    setQuad(&boardQuad[0], lines, local, Color::White);
+
+    /* the icons aren't placed until the atlas is built (which sets the
+       uniforms itself) */
+    if (not atlasStale) {
+        setUniforms();
+    }
+}
+
+/*
+ * writeTexel
+ * purpose: Write a cell's texel for the shader
+ * parameters:
+ *        int row : The row of the cell
+ *        int col : The column of the cell
+ *      int state : What the cell is drawn as (see cellState)
+ * returns: n/a
+ * note: The texel is uploaded by the next call to uploadTexels
+ */
+void BoardRenderer::writeTexel(int row, int col, int state)
+{
+    Uint8 *texel = &texels[((row * numCols) + col) * 4];
+    texel[0] = (state > 0) ? state : 0;
+    texel[1] = (state == MINE) ? TEXEL_MINE : ((state >= 0) ? TEXEL_SHOWN : TEXEL_HIDDEN);
+    texel[2] = (state == FLAG_STATE) ? TEXEL_FLAG : 0;
+    texel[3] = 255;
+
+    /* grow the rectangle of changed texels to cover the cell */
+    if ((changed.width == 0) or (changed.height == 0)) {
+        changed = IntRect(col, row, 1, 1);
+        return;
+    }
+    int right = max(changed.left + changed.width, col + 1);
+    int bottom = max(changed.top + changed.height, row + 1);
+    changed.left = min(changed.left, col);
+    changed.top = min(changed.top, row);
+    changed.width = right - changed.left;
+    changed.height = bottom - changed.top;
+}
+
+/*
+ * uploadTexels
+ * purpose: Upload the rectangle of texels that changed since the last upload
+ * parameters: n/a
+ * returns: n/a
+ */
+void BoardRenderer::uploadTexels()
+{
+    if ((changed.width == 0) or (changed.height == 0)) {
+        return;
+    }
+    uploadBuffer.resize(changed.width * changed.height * 4);
+    for (int row = 0; row < changed.height; ++row) {
+        const Uint8 *source = &texels[(((changed.top + row) * numCols) + changed.left) * 4];
+        copy(source, source + (changed.width * 4), &uploadBuffer[row * changed.width * 4]);
+    }
+    cellTexture.update(&uploadBuffer[0], changed.width, changed.height, changed.left, changed.top);
+    changed = IntRect();
+}
+
+/*
+ * setUniforms
+ * purpose: Give the shader the board's size, colors, textures and where each
+ *          image is in the atlas and drawn in a cell
+ * parameters: n/a
+ * returns: n/a
+ * note: Icons whose quads haven't been cached yet are given an empty area
+ */
+void BoardRenderer::setUniforms()
+{
+    shader.setUniform("cells", cellTexture);
+    shader.setUniform("atlas", atlas.getTexture());
+    Vector2u atlasSize = atlas.getTexture().getSize();
+    shader.setUniform("gridSize", Vector2f(numCols, numRows));
+    shader.setUniform("atlasSize", Vector2f(atlasSize.x, atlasSize.y));
+    shader.setUniform("cellSize", cellScaler);
+    shader.setUniform("thickness", thickness);
+    shader.setUniform("hiddenColor", Glsl::Vec4(hiddenColor));
+    shader.setUniform("shownColor", Glsl::Vec4(shownColor));
+    shader.setUniform("mineColor", Glsl::Vec4(mineColor));
+    shader.setUniform("lineColor", Glsl::Vec4(lineColor));
+
+    /* the numbers, the flag and the mine, from the corners of their quads
+       (an empty area if not loaded) */
+    Glsl::Vec4 rects[NUM_ICONS], areas[NUM_ICONS];
+    for (int icon = 0; icon < NUM_ICONS; ++icon) {
+        const Vertex &topLeft = iconQuads[icon * QUAD_VERTICES];
+        const Vertex &bottomRight = iconQuads[(icon * QUAD_VERTICES) + 2];
+        Vector2f texSize = bottomRight.texCoords - topLeft.texCoords;
+        Vector2f size = bottomRight.position - topLeft.position;
+        rects[icon] = Glsl::Vec4(topLeft.texCoords.x, topLeft.texCoords.y, texSize.x, texSize.y);
+        areas[icon] = Glsl::Vec4(topLeft.position.x, topLeft.position.y, size.x, size.y);
+    }
+    shader.setUniformArray("iconRects", rects, NUM_ICONS);
+    shader.setUniformArray("iconAreas", areas, NUM_ICONS);
+}
@@ -0,0 +1,92 @@
+/*
+ * Project: minesweeper
+ * Name: Bot.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the Bot class. Opens in the middle of the board,
+ *          then each turn clicks every cell found safe by the Solver's direct
+ *          deductions, counting arrangements only when those find nothing,
+ *          and guesses the least likely mine when no cell is certain.
+ */
+
+#include "../Files_h/Bot.h"
+#include "../Files_h/Solver.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <algorithm>
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * Bot
+ * purpose: Initialize a bot
+ * parameters: n/a
+ * returns: n/a
+ */
+Bot::Bot()
+{
+}
+
+
+/******************************************************\
+ *                  Play Functions                     *
+\******************************************************/
+
+/*
+ * play
+ * purpose: Play a whole game on the given board
+ * parameters:
+ *      Board &board : A board that has been set but not played
+ * returns: True if the game was won, false if a mine was hit
+ * note: The number of clicks is the size of board.getMoves()
+ */
+bool Bot::play(Board &board)
+{
+    int rows = board.getNumRows(), cols = board.getNumCols();
+    int outcome = NO_SPACE;
+    while ((outcome != MINE_HIT) and (not board.won())) {
+        board.getVisible(visible);
+        vector<Pos> moves = nextMoves(visible, rows, cols, board.getNumBombs());
+        for (size_t i = 0; (i < moves.size()) and (outcome != MINE_HIT); ++i) {
+            outcome = board.move(moves[i].first, moves[i].second);
+        }
+    }
+    return outcome != MINE_HIT;
+}
+
+/*
+ * nextMoves
+ * purpose: Choose the cells to click this turn
+ * parameters:
+ *      const vector<int> &cells : The visible board in row major order (see
+ *                                 Board::getVisible)
+ *                      int rows : Number of rows on the board
+ *                      int cols : Number of columns on the board
+ *                     int mines : Total number of mines on the board
+ * returns: The middle cell on an unopened board, every cell certain to be 
+ *          safe, or the single best guess if no cell is certain
+ */
+vector<Pos> Bot::nextMoves(const vector<int> &cells, int rows, int cols, int mines)
+{
+    /* open in the middle of the board */
+    if (count(cells.begin(), cells.end(), HIDDEN) == (long)cells.size()) {
+        return vector<Pos>(1, make_pair(rows / 2, cols / 2));
+    }
+
+    /* click the safe cells, counting arrangements only if needed */
+    solver.solveSimple(cells, rows, cols, mines);
+    vector<Pos> moves = solver.safeCells();
+    if (moves.empty()) {
+        solver.solve(cells, rows, cols, mines);
+        moves = solver.safeCells();
+    }
+
+    /* otherwise guess */
+    if (moves.empty()) {
+        moves.push_back(solver.bestGuess());
+    }
+    return moves;
+}
@@ -5,15 +5,19 @@
  * Purpose: Implementation for the EndingMenu class. Declares the functions 
  *          that display the ending menu for the user which includes a win/loss
  *          message, the difficulty of the game, the number of wins on the
- *          difficulty, the time elasped, the best time recorded, and quit
- *          and continue buttons.
+ *          difficulty, the time elasped, the best time recorded, the 
+ *          analysis of the user's moves, and quit and continue buttons.
  */
 
 #include <string>
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
 #include "../Files_h/EndingMenu.h"
+#include "../Files_h/GameAnalysis.h"
 #include "../Files_h/SFMLhelper.h"
 #include "../Files_h/EM_Constants.h"
 #include "../Files_h/Game_Constants.h"
@@ -29,14 +33,16 @@
  * EndingMenu
  * purpose: Initialize the ending screen window and images
  * parameters:
- *         bool gameWon : Whether or not the game was won
- *            Time time : The time elasped during the game   
- *      int &difficulty : The difficulty the game was played on
+ *                     bool gameWon : Whether or not the game was won
+ *                        Time time : The time elasped during the game   
+ *                  int &difficulty : The difficulty the game was played on
+ *      GameAnalysis &gameAnalysis : Analysis of the game running in the 
+ *                                   background
  * returns: n/a
  * expectations: The difficulty is between 0 and the total number of 
  *               difficulties
  */
-EndingMenu::EndingMenu(bool gameWon, Time time, int &difficulty)
+EndingMenu::EndingMenu(bool gameWon, Time time, int &difficulty, GameAnalysis &gameAnalysis)
 {
     /* check if difficulty is valid */
     assert(difficulty >= 0 and difficulty < NUM_DIFFS);
@@ -50,6 +56,12 @@ EndingMenu::EndingMenu(bool gameWon, Time time, int &difficulty)
     setTimes(gameWon, time, difficulty);
     quit = SFML.makeTextBox(QUIT_TEXTBOX.rectangleData, QUIT_TEXTBOX.textData);
     cont = SFML.makeTextBox(CONT_TEXTBOX.rectangleData, CONT_TEXTBOX.textData);
+
+    /* show whatever the analysis has found so far */
+    analysis = &gameAnalysis;
+    analysisShown = analysis->getResults();
+    analysisText = SFML.makeTextBox(ANALYSIS_BOX, ANALYSIS_TEXT);
+    setAnalysisText();
 }
 
 
@@ -81,19 +93,41 @@ bool EndingMenu::playAgain()
     bool soundEffectDone = false;
     while (window.isOpen()) {
 
+        /* sleep until there is an event, waking up to check on the analysis
+           and the sound effect while they aren't finished */
         Event event;
-        while (window.pollEvent(event)) {
+        bool gotEvent;
+        if (not analysisShown.done) {
+            gotEvent = SFML.waitEvent(window, event, milliseconds(ANALYSIS_POLL_DELAY));
+        } else if (not soundEffectDone) {
+            gotEvent = SFML.waitEvent(window, event, delay - clock.getElapsedTime());
+        } else {
+            gotEvent = window.waitEvent(event);
+        }
+
+        bool redraw = false;
+        while (gotEvent) {
 
             /* check if user exited the window */
             if (event.type == Event::Closed) {
+                analysis->cancel();
                 window.close();    
                 return false;            
             }
 
             if ((SFML.leftClick(event)) and (decision(window))) {
+                analysis->cancel();
                 playSound();
                 return again;                 
             }
+
+            redraw = redraw or SFML.needsRedraw(event);
+            gotEvent = window.pollEvent(event);
+        }
+
+        /* redraw when the analysis finds something new */
+        if ((updateAnalysis()) or (redraw)) {
+            draw(window);
         }
 
         /* play music if sound effect finishes */
@@ -166,6 +200,7 @@ void EndingMenu::draw(RW &window)
     SFML.drawTextBox(window, time);
     SFML.drawTextBox(window, quit);
     SFML.drawTextBox(window, cont);
+    SFML.drawTextBox(window, analysisText);
 
     /* display image */
     window.display();
@@ -380,6 +415,61 @@ bool EndingMenu::setBestTime(bool &gameWon, Time &time, string file)
     return false;
 }
 
+/* 
+ * updateAnalysis
+ * purpose: Check the game analysis for new results
+ * parameters: n/a
+ * returns: True if the analysis text changed, false if there were no new 
+ *          results
+ */
+bool EndingMenu::updateAnalysis()
+{
+    /* return if nothing new was found */
+    analysisResults latest = analysis->getResults();
+    bool changed = (latest.movesAnalyzed != analysisShown.movesAnalyzed) 
+                   or (latest.done != analysisShown.done);
+    if (not changed) {
+        return false;
+    }
+
+    /* show the new results */
+    analysisShown = latest;
+    setAnalysisText();
+    return true;
+}
+
+/* 
+ * setAnalysisText
+ * purpose: Set the analysis text to the progress of the analysis or the 
+ *          grades of the user's moves once it is done, with the bot win rate
+ *          of the first click and of the best first click
+ * parameters: n/a
+ * returns: n/a
+ */
+void EndingMenu::setAnalysisText()
+{
+    stringstream ss;
+    ss << fixed << setprecision(0);
+    if (not analysisShown.done) {
+        ss << ANALYZING 
+           << min(analysisShown.movesAnalyzed + 1, analysisShown.totalMoves) 
+           << "/" << analysisShown.totalMoves;
+    } else {
+        ss << "SAFE: " << analysisShown.forcedSafe
+           << "  GUESSES: " << analysisShown.necessaryGuesses
+           << "  RISKS: " << analysisShown.unnecessaryRisks << "\n"
+           << "LUCK: " << analysisShown.luck * 100 << "%";
+        if (analysisShown.lossChance >= 0) {
+            ss << "  LOSS ODDS: " << analysisShown.lossChance * 100 << "%";
+        }
+        if (analysisShown.firstClickWin >= 0) {
+            ss << "\nFIRST CLICK: " << analysisShown.firstClickWin * 100 
+               << "%  BEST: " << analysisShown.bestFirstClickWin * 100 << "%";
+        }
+    }
+    SFML.setString(ss.str(), analysisText.text, analysisText.box);
+}
+
 
 /******************************************************\
  *             Image Helper Function                   *
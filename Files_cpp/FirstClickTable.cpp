@@ -0,0 +1,227 @@
+/*
+ * Project: minesweeper
+ * Name: FirstClickTable.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the FirstClickTable class. The table is saved as
+ *          the raw totals rather than rates so that tables from separate runs
+ *          can be added together. Each difficulty is a header line followed by
+ *          one line per row with "games wins opened" for each column.
+ */
+
+#include "../Files_h/FirstClickTable.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cassert>
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * FirstClickTable
+ * purpose: Initialize a table with no games for every cell
+ * parameters: n/a
+ * returns: n/a
+ */
+FirstClickTable::FirstClickTable()
+{
+    firstClickStats empty = {0, 0, 0};
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        cells[diff].assign(DIFF_ROWS[diff] * DIFF_COLS[diff], empty);
+    }
+}
+
+
+/******************************************************\
+ *                  File Functions                     *
+\******************************************************/
+
+/*
+ * load
+ * purpose: Add the totals saved in a file to the table
+ * parameters:
+ *      const string &filename : The file to read
+ * returns: True if the file was read, false if it couldn't be opened or a
+ *          difficulty's size didn't match the game's
+ */
+bool FirstClickTable::load(const string &filename)
+{
+    ifstream input(filename);
+    if (not input.is_open()) {
+        return false;
+    }
+
+    string tag, name;
+    int rows, cols;
+    while (input >> tag >> name >> rows >> cols) {
+
+        /* find the difficulty */
+        int diff = 0;
+        while ((diff < NUM_DIFFS) and (DIFF_NAMES[diff] != name)) {
+            ++diff;
+        }
+        if ((tag != "FIRSTCLICK") or (diff == NUM_DIFFS) or
+            (rows != DIFF_ROWS[diff]) or (cols != DIFF_COLS[diff])) {
+            return false;
+        }
+
+        /* add its totals */
+        for (int cell = 0; cell < rows * cols; ++cell) {
+            firstClickStats stats;
+            if (not (input >> stats.games >> stats.wins >> stats.opened)) {
+                return false;
+            }
+            add(diff, cell / cols, cell % cols, stats);
+        }
+    }
+    return true;
+}
+
+/*
+ * save
+ * purpose: Write the table to a file
+ * parameters:
+ *      const string &filename : The file to write
+ * returns: True if the file was written, false if it couldn't be opened
+ */
+bool FirstClickTable::save(const string &filename)
+{
+    ofstream output(filename);
+    if (not output.is_open()) {
+        return false;
+    }
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff];
+        output << "FIRSTCLICK " << DIFF_NAMES[diff] << " " << rows << " " << cols << "\n";
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                firstClickStats &stats = cells[diff][(row * cols) + col];
+                output << ((col == 0) ? "" : "  ") << stats.games << " " 
+                       << stats.wins << " " << stats.opened;
+            }
+            output << "\n";
+        }
+    }
+    return output.good();
+}
+
+
+/******************************************************\
+ *                   Add Functions                     *
+\******************************************************/
+
+/*
+ * add
+ * purpose: Add games played from one first click to the table
+ * parameters:
+ *                         int difficulty : The difficulty played
+ *                                int row : The row of the first click
+ *                                int col : The column of the first click
+ *      const firstClickStats &stats : The totals of the games
+ * returns: n/a
+ * expectations: The difficulty and cell are valid. CRE if violated.
+ */
+void FirstClickTable::add(int difficulty, int row, int col, const firstClickStats &stats)
+{
+    assert(difficulty >= 0 and difficulty < NUM_DIFFS);
+    assert(row >= 0 and row < DIFF_ROWS[difficulty] and col >= 0 and col < DIFF_COLS[difficulty]);
+    firstClickStats &cell = cells[difficulty][(row * DIFF_COLS[difficulty]) + col];
+    cell.games += stats.games;
+    cell.wins += stats.wins;
+    cell.opened += stats.opened;
+}
+
+/*
+ * add
+ * purpose: Add every game of another table to this one
+ * parameters:
+ *      const FirstClickTable &other : The table to add
+ * returns: n/a
+ */
+void FirstClickTable::add(const FirstClickTable &other)
+{
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        for (size_t i = 0; i < cells[diff].size(); ++i) {
+            add(diff, i / DIFF_COLS[diff], i % DIFF_COLS[diff], other.cells[diff][i]);
+        }
+    }
+}
+
+
+/******************************************************\
+ *                      Getters                        *
+\******************************************************/
+
+/*
+ * getStats
+ * purpose: Returns the totals of the games played from a first click
+ * parameters:
+ *      int difficulty : The difficulty
+ *             int row : The row of the first click
+ *             int col : The column of the first click
+ * returns: The number of games played and won, and the cells opened
+ * expectations: The difficulty and cell are valid. CRE if violated.
+ */
+firstClickStats FirstClickTable::getStats(int difficulty, int row, int col)
+{
+    assert(difficulty >= 0 and difficulty < NUM_DIFFS);
+    assert(row >= 0 and row < DIFF_ROWS[difficulty] and col >= 0 and col < DIFF_COLS[difficulty]);
+    return cells[difficulty][(row * DIFF_COLS[difficulty]) + col];
+}
+
+/*
+ * winRate
+ * purpose: Returns the fraction of games the Bot won from a first click
+ * parameters:
+ *      int difficulty : The difficulty
+ *             int row : The row of the first click
+ *             int col : The column of the first click
+ * returns: The win rate, or -1 if no games were played from the cell
+ */
+double FirstClickTable::winRate(int difficulty, int row, int col)
+{
+    firstClickStats stats = getStats(difficulty, row, col);
+    return (stats.games == 0) ? -1 : (double)stats.wins / stats.games;
+}
+
+/*
+ * openingSize
+ * purpose: Returns the average number of cells a first click opened
+ * parameters:
+ *      int difficulty : The difficulty
+ *             int row : The row of the first click
+ *             int col : The column of the first click
+ * returns: The average cells opened, or -1 if no games were played from the
+ *          cell
+ */
+double FirstClickTable::openingSize(int difficulty, int row, int col)
+{
+    firstClickStats stats = getStats(difficulty, row, col);
+    return (stats.games == 0) ? -1 : (double)stats.opened / stats.games;
+}
+
+/*
+ * bestCell
+ * purpose: Find the first click with the highest win rate
+ * parameters:
+ *      int difficulty : The difficulty
+ * returns: The best cell, or (-1, -1) if the difficulty has no games
+ */
+Pos FirstClickTable::bestCell(int difficulty)
+{
+    Pos best = make_pair(-1, -1);
+    double bestRate = -1;
+    for (int row = 0; row < DIFF_ROWS[difficulty]; ++row) {
+        for (int col = 0; col < DIFF_COLS[difficulty]; ++col) {
+            double rate = winRate(difficulty, row, col);
+            if (rate > bestRate) {
+                bestRate = rate;
+                best = make_pair(row, col);
+            }
+        }
+    }
+    return best;
+}
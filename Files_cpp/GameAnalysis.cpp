@@ -0,0 +1,195 @@
+/*
+ * Project: minesweeper
+ * Name: GameAnalysis.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the GameAnalysis class. Replays the moves of a
+ *          finished game on a copy of its board in a background thread and
+ *          grades each click with the Solver. The results can be read at any
+ *          time while the replay is running.
+ */
+
+#include "../Files_h/GameAnalysis.h"
+#include "../Files_h/Solver.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/FirstClickTable.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+
+
+/******************************************************\
+ *             Constructor and Destructor              *
+\******************************************************/
+
+/*
+ * GameAnalysis
+ * purpose: Save the mines and moves of the finished game and look up the bot
+ *          win rate of its first click
+ * parameters:
+ *                Board &board : The board the game was played on
+ *      FirstClickTable &table : Bot win rates of every first click
+ *              int difficulty : The difficulty the game was played on
+ * returns: n/a
+ * note: start must be called to begin the analysis
+ */
+GameAnalysis::GameAnalysis(Board &board, FirstClickTable &table, int difficulty)
+{
+    numRows = board.getNumRows();
+    numCols = board.getNumCols();
+    mines = board.getMines();
+    moves = board.getMoves();
+    cancelled = false;
+
+    /* nothing has been analyzed yet */
+    results.movesAnalyzed = 0;
+    results.totalMoves = moves.size();
+    results.forcedSafe = results.necessaryGuesses = results.unnecessaryRisks = 0;
+    results.luck = 1;
+    results.lossChance = -1;
+    results.done = false;
+
+    /* the first click's win rate (-1 if there is no table or no click) */
+    results.firstClickWin = results.bestFirstClickWin = -1;
+    if (not moves.empty()) {
+        Pos best = table.bestCell(difficulty);
+        results.firstClickWin = table.winRate(difficulty, moves[0].first, moves[0].second);
+        if (best.first >= 0) {
+            results.bestFirstClickWin = table.winRate(difficulty, best.first, best.second);
+        }
+    }
+}
+
+/*
+ * ~GameAnalysis
+ * purpose: Stop the analysis and wait for the worker thread to finish
+ * parameters: n/a
+ * returns: n/a
+ */
+GameAnalysis::~GameAnalysis()
+{
+    cancel();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+
+/******************************************************\
+ *                   Run Functions                     *
+\******************************************************/
+
+/*
+ * start
+ * purpose: Begin replaying the game on a background thread
+ * parameters: n/a
+ * returns: n/a
+ */
+void GameAnalysis::start()
+{
+    worker = thread(&GameAnalysis::run, this);
+}
+
+/*
+ * cancel
+ * purpose: Tell the worker thread to stop, in the middle of the move it is
+ *          analyzing if its solve is still counting
+ * parameters: n/a
+ * returns: n/a
+ */
+void GameAnalysis::cancel()
+{
+    cancelled = true;
+}
+
+
+/******************************************************\
+ *                      Getter                         *
+\******************************************************/
+
+/*
+ * getResults
+ * purpose: Returns a copy of the results found so far
+ * parameters: n/a
+ * returns: The analysis results (done is true once every move is analyzed)
+ */
+analysisResults GameAnalysis::getResults()
+{
+    lock_guard<mutex> guard(resultsLock);
+    return results;
+}
+
+
+/******************************************************\
+ *                  Helper Function                    *
+\******************************************************/
+
+/*
+ * run
+ * purpose: Replay each move on a copy of the board, solving the board before
+ *          each click to grade it
+ * parameters: n/a
+ * returns: n/a
+ * note: Runs on the worker thread. The luck is the chance of surviving every
+ *       guess the user survived, and the loss chance is the chance that the
+ *       losing click was a mine.
+ */
+void GameAnalysis::run()
+{
+    /* nothing to replay if the game ended before the board was dealt */
+    if (moves.empty()) {
+        lock_guard<mutex> guard(resultsLock);
+        results.done = true;
+        return;
+    }
+
+    /* rebuild the board with the same mines */
+    Board replay;
+    replay.setBoard(numCols, numRows, mines.size());
+    replay.setLayout(mines);
+
+    /* grade each move (a solve stops early if cancelled) */
+    Solver solver;
+    solver.setCancel(&cancelled);
+    vector<int> cells;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        if (cancelled) {
+            return;
+        }
+        int row = moves[i].first, col = moves[i].second;
+
+        /* solve the board as the user saw it (the first click is always safe) */
+        double chance = 0;
+        bool forced = (i == 0), safeElsewhere = false;
+        if (not forced) {
+            replay.getVisible(cells);
+            solver.solve(cells, numRows, numCols, mines.size());
+            if (cancelled) {
+                return;
+            }
+            chance = solver.mineProbability(row, col);
+            forced = solver.isSafe(row, col);
+            safeElsewhere = not solver.safeCells().empty();
+        }
+        bool hit = (replay.move(row, col) == MINE_HIT);
+
+        /* record the grade */
+        lock_guard<mutex> guard(resultsLock);
+        if (forced) {
+            ++results.forcedSafe;
+        } else if (safeElsewhere) {
+            ++results.unnecessaryRisks;
+        } else {
+            ++results.necessaryGuesses;
+        }
+        if (hit) {
+            results.lossChance = chance;
+        } else {
+            results.luck *= 1 - chance;
+        }
+        ++results.movesAnalyzed;
+    }
+
+    lock_guard<mutex> guard(resultsLock);
+    results.done = true;
+}
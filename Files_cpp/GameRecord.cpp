@@ -0,0 +1,240 @@
+/*
+ * Project: minesweeper
+ * Name: GameRecord.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the GameRecord class. A record is saved as text:
+ *          a "GAMERECORD <difficulty> <rows> <cols> <mines> <length>" line,
+ *          a "<row> <col>" line for each mine, then a
+ *          "<time> <reveal|flag> <row> <col>" line for each click.
+ */
+
+#include "../Files_h/GameRecord.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+
+/******************************************************\
+ *                    Constructor                      *
+\******************************************************/
+
+/*
+ * GameRecord
+ * purpose: Initialize an empty record of an easy game
+ * parameters: n/a
+ * returns: n/a
+ */
+GameRecord::GameRecord()
+{
+    start(0);
+}
+
+
+/******************************************************\
+ *                     Recording                       *
+\******************************************************/
+
+/*
+ * start
+ * purpose: Empty the record for a new game
+ * parameters:
+ *      int difficulty : The game's difficulty (index of DIFF_NAMES)
+ * returns: n/a
+ */
+void GameRecord::start(int difficulty)
+{
+    diff = difficulty;
+    length = 0;
+    mines.clear();
+    moves.clear();
+}
+
+/*
+ * add
+ * purpose: Record a click
+ * parameters:
+ *      long time : When the click was made (milliseconds into the game)
+ *      bool flag : True if a flag was placed or removed, false if the cell
+ *                  was revealed
+ *        int row : The row of the cell
+ *        int col : The column of the cell
+ * returns: n/a
+ */
+void GameRecord::add(long time, bool flag, int row, int col)
+{
+    recordedMove move = {time, flag, row, col};
+    moves.push_back(move);
+}
+
+/*
+ * finish
+ * purpose: Record how the game ended
+ * parameters:
+ *                        long time : How long the game lasted
+ *                                    (milliseconds)
+ *      const vector<Pos> &mineLocs : Where the mines were
+ * returns: n/a
+ */
+void GameRecord::finish(long time, const vector<Pos> &mineLocs)
+{
+    length = time;
+    mines = mineLocs;
+}
+
+
+/******************************************************\
+ *                   File Functions                    *
+\******************************************************/
+
+/*
+ * load
+ * purpose: Read a record from a file
+ * parameters:
+ *      const string &filename : The file to read
+ * returns: True if the file was read, false if it couldn't be opened or
+ *          isn't a record of a game of one of the difficulties
+ */
+bool GameRecord::load(const string &filename)
+{
+    ifstream input(filename);
+    if (not input.is_open()) {
+        return false;
+    }
+
+    /* find the difficulty */
+    string tag, name;
+    int rows, cols;
+    size_t numMines;
+    if (not (input >> tag >> name >> rows >> cols >> numMines >> length)) {
+        return false;
+    }
+    diff = find(DIFF_NAMES, DIFF_NAMES + NUM_DIFFS, name) - DIFF_NAMES;
+    if ((tag != "GAMERECORD") or (diff == NUM_DIFFS) or (rows != DIFF_ROWS[diff]) or
+        (cols != DIFF_COLS[diff]) or (numMines > (size_t)(rows * cols))) {
+        return false;
+    }
+
+    /* read the mines, then the clicks */
+    mines.assign(numMines, make_pair(0, 0));
+    for (size_t i = 0; i < numMines; ++i) {
+        if ((not (input >> mines[i].first >> mines[i].second)) or
+            (mines[i].first < 0) or (mines[i].first >= rows) or
+            (mines[i].second < 0) or (mines[i].second >= cols)) {
+            return false;
+        }
+    }
+    moves.clear();
+    string kind;
+    recordedMove move;
+    while (input >> move.time >> kind >> move.row >> move.col) {
+        if (((kind != "reveal") and (kind != "flag")) or (move.row < 0) or
+            (move.row >= rows) or (move.col < 0) or (move.col >= cols) or
+            ((not moves.empty()) and (move.time < moves.back().time))) {
+            return false;
+        }
+        move.flag = (kind == "flag");
+        moves.push_back(move);
+    }
+    return input.eof();
+}
+
+/*
+ * save
+ * purpose: Write the record to a file
+ * parameters:
+ *      const string &filename : The file to write
+ * returns: True if the file was written, false if it couldn't be opened
+ */
+bool GameRecord::save(const string &filename)
+{
+    ofstream output(filename);
+    if (not output.is_open()) {
+        return false;
+    }
+    output << "GAMERECORD " << DIFF_NAMES[diff] << " " << DIFF_ROWS[diff] << " "
+           << DIFF_COLS[diff] << " " << mines.size() << " " << length << "\n";
+    for (size_t i = 0; i < mines.size(); ++i) {
+        output << mines[i].first << " " << mines[i].second << "\n";
+    }
+    for (size_t i = 0; i < moves.size(); ++i) {
+        output << moves[i].time << (moves[i].flag ? " flag " : " reveal ")
+               << moves[i].row << " " << moves[i].col << "\n";
+    }
+    return output.good();
+}
+
+
+/******************************************************\
+ *                     Replaying                       *
+\******************************************************/
+
+/*
+ * deal
+ * purpose: Set up a board with the record's mines, before the first click
+ * parameters:
+ *      Board &board : A board that setBoard hasn't been called on
+ * returns: n/a
+ */
+void GameRecord::deal(Board &board)
+{
+    board.setBoard(DIFF_COLS[diff], DIFF_ROWS[diff], mines.size());
+    board.setLayout(mines);
+}
+
+/*
+ * play
+ * purpose: Make a recorded click on a board
+ * parameters:
+ *                   Board &board : The board (dealt by deal)
+ *      const recordedMove &move : The click
+ * returns: n/a
+ */
+void GameRecord::play(Board &board, const recordedMove &move)
+{
+    if (move.flag) {
+        board.placeFlag(move.row, move.col);
+    } else {
+        board.move(move.row, move.col);
+    }
+}
+
+
+/******************************************************\
+ *                      Getters                        *
+\******************************************************/
+
+/*
+ * getDifficulty
+ * purpose: Returns the game's difficulty
+ * parameters: n/a
+ * returns: The index of the difficulty in DIFF_NAMES
+ */
+int GameRecord::getDifficulty()
+{
+    return diff;
+}
+
+/*
+ * getLength
+ * purpose: Returns how long the game lasted
+ * parameters: n/a
+ * returns: The length of the game in milliseconds
+ */
+long GameRecord::getLength()
+{
+    return length;
+}
+
+/*
+ * getMoves
+ * purpose: Returns the recorded clicks
+ * parameters: n/a
+ * returns: Every click, in the order they were made
+ */
+const vector<recordedMove> &GameRecord::getMoves()
+{
+    return moves;
+}
@@ -0,0 +1,279 @@
+/*
+ * Project: minesweeper
+ * Name: Generator.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the Generator class. Each worker thread deals
+ *          random boards with the usual free space around the first move and
+ *          plays them with the Solver, only ever clicking cells it can prove
+ *          are safe. The first board that gets won this way is kept and the
+ *          other workers stop.
+ */
+
+#include "../Files_h/Generator.h"
+#include "../Files_h/Solver.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+
+/* boards to try before giving up (the board is then dealt normally) */
+static const long MAX_TRIES = 50000;
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * Generator
+ * purpose: Initialize a generator with no board
+ * parameters: n/a
+ * returns: n/a
+ */
+Generator::Generator()
+{
+    numRows = numCols = numMines = 0;
+    first = make_pair(0, 0);
+    numWorkers = max(1u, thread::hardware_concurrency());
+    found = cancelled = false;
+    tried = rejected = 0;
+    stats.boardsTried = stats.boardsRejected = 0;
+    stats.seconds = 0;
+}
+
+
+/*
+ * setWorkers
+ * purpose: Set the number of threads that deal and check boards
+ * parameters:
+ *      unsigned workers : Number of threads (at least 1)
+ * returns: n/a
+ */
+void Generator::setWorkers(unsigned workers)
+{
+    numWorkers = max(1u, workers);
+}
+
+
+/******************************************************\
+ *                 Generate Functions                  *
+\******************************************************/
+
+/*
+ * generate
+ * purpose: Find the mine locations of a board that can be solved from the
+ *          first move without guessing
+ * parameters:
+ *           int rows : Number of rows on the board
+ *           int cols : Number of columns on the board
+ *          int mines : Number of mines on the board
+ *      Pos firstMove : The cell of the first move
+ *      unsigned seed : Seed for the workers' random boards
+ * returns: The mine locations, or an empty vector if no board was found
+ *          within MAX_TRIES or the generator was cancelled
+ * expectations: The first move is in bounds and the mines fit outside of the
+ *               free space around it. CRE if violated.
+ */
+vector<Pos> Generator::generate(int rows, int cols, int mines, Pos firstMove, unsigned seed)
+{
+    assert(firstMove.first >= 0 and firstMove.first < rows);
+    assert(firstMove.second >= 0 and firstMove.second < cols);
+
+    /* reset the shared state */
+    numRows = rows;
+    numCols = cols;
+    numMines = mines;
+    first = firstMove;
+    found = false;
+    tried = rejected = 0;
+    result.clear();
+
+    /* run the workers until one finds a board */
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned i = 0; i < numWorkers; ++i) {
+        workers.push_back(thread(&Generator::work, this, seed + i));
+    }
+    for (unsigned i = 0; i < numWorkers; ++i) {
+        workers[i].join();
+    }
+
+    /* save the statistics */
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    stats.boardsTried = tried;
+    stats.boardsRejected = rejected;
+    stats.seconds = elapsed.count();
+
+    return result;
+}
+
+/*
+ * cancel
+ * purpose: Stop generating (from another thread)
+ * parameters: n/a
+ * returns: n/a
+ * note: generate returns an empty vector once the workers notice
+ */
+void Generator::cancel()
+{
+    cancelled = true;
+}
+
+
+/*
+ * isSolvable
+ * purpose: Check whether a board can be solved from the first move without
+ *          guessing
+ * parameters:
+ *                 int rows : Number of rows on the board
+ *                 int cols : Number of columns on the board
+ *            Pos firstMove : The cell of the first move
+ *      const vector<Pos> &mines : The mine locations
+ * returns: True if every safe cell can be revealed without guessing
+ * note: Must not be called while generate is running
+ */
+bool Generator::isSolvable(int rows, int cols, Pos firstMove, const vector<Pos> &mines)
+{
+    numRows = rows;
+    numCols = cols;
+    numMines = mines.size();
+    first = firstMove;
+    found = false;
+    return solvable(mines);
+}
+
+
+/******************************************************\
+ *                      Getter                         *
+\******************************************************/
+
+/*
+ * getStats
+ * purpose: Returns the statistics of the last call to generate
+ * parameters: n/a
+ * returns: The number of boards tried and rejected and the time taken
+ */
+generatorStats Generator::getStats()
+{
+    return stats;
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * work
+ * purpose: Deal and check random boards until a board is found, the tries
+ *          run out, or the generator is cancelled
+ * parameters:
+ *      unsigned seed : Seed for this worker's boards
+ * returns: n/a
+ * note: Runs on a worker thread
+ */
+void Generator::work(unsigned seed)
+{
+    mt19937 gen(seed);
+
+    /* cells that may have a mine (not close to the first move) */
+    vector<Pos> allowed;
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            bool close = (abs(row - first.first) <= SAFE_RADIUS) and (abs(col - first.second) <= SAFE_RADIUS);
+            if (not close) {
+                allowed.push_back(make_pair(row, col));
+            }
+        }
+    }
+    assert((int)allowed.size() >= numMines);
+
+    while ((not stopped()) and (tried++ < MAX_TRIES)) {
+
+        /* pick the mines by shuffling the front of the allowed cells */
+        for (int i = 0; i < numMines; ++i) {
+            uniform_int_distribution<> dis(i, allowed.size() - 1);
+            swap(allowed[i], allowed[dis(gen)]);
+        }
+        vector<Pos> mines(allowed.begin(), allowed.begin() + numMines);
+
+        /* keep the board if it's the first solvable one */
+        if (not solvable(mines)) {
+            ++rejected;
+            continue;
+        }
+        lock_guard<mutex> guard(resultLock);
+        if (not found) {
+            result = mines;
+            found = true;
+        }
+    }
+}
+
+/*
+ * solvable
+ * purpose: Play the board from the first move, only revealing cells the
+ *          Solver proves are safe
+ * parameters:
+ *      const vector<Pos> &mines : The mine locations
+ * returns: True if every safe cell could be revealed, false if a guess was
+ *          needed, the Solver couldn't count the board exactly, a mine was
+ *          hit or another worker already finished
+ */
+bool Generator::solvable(const vector<Pos> &mines)
+{
+    Board board;
+    board.setBoard(numCols, numRows, numMines);
+    board.setLayout(mines);
+    if (board.move(first.first, first.second) == MINE_HIT) {
+        return false;
+    }
+
+    Solver solver;
+    vector<int> cells;
+    while (not board.won()) {
+        if (stopped()) {
+            return false;
+        }
+
+        /* find the safe cells, only counting arrangements if needed (an
+           estimate proves nothing) */
+        board.getVisible(cells);
+        solver.solveSimple(cells, numRows, numCols, numMines);
+        vector<Pos> safe = solver.safeCells();
+        if (safe.empty()) {
+            solver.solve(cells, numRows, numCols, numMines);
+            if (not solver.exact()) {
+                return false;
+            }
+            safe = solver.safeCells();
+        }
+        if (safe.empty()) {
+            return false;
+        }
+
+        /* reveal every cell that is certain to be safe */
+        for (size_t i = 0; i < safe.size(); ++i) {
+            if (board.move(safe[i].first, safe[i].second) == MINE_HIT) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * stopped
+ * purpose: Returns whether the workers should stop
+ * parameters: n/a
+ * returns: True if a board was found or the generator was cancelled
+ */
+bool Generator::stopped()
+{
+    return found or cancelled;
+}
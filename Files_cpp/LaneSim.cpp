@@ -0,0 +1,408 @@
+/*
+ * Project: minesweeper
+ * Name: LaneSim.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the LaneSim class. Every step reveals the clicks
+ *          of all lanes with a flood fill on the bit planes, checks which games
+ *          are over (dealing the next game into that lane), then finds each
+ *          game's safe cells and mines with the same rules as 
+ *          Solver::solveSimple. A lane with nothing certain guesses a random
+ *          unknown cell. The numbers are stored bit sliced (one plane per bit)
+ *          so comparing counts is a few word operations. Each plane operation 
+ *          is a plain loop over the lanes, which the compiler turns into 
+ *          vector instructions when optimizing.
+ */
+
+#include "../Files_h/LaneSim.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cassert>
+
+
+/*
+ * nextRandom
+ * purpose: Step a splitmix64 random number generator
+ * parameters:
+ *      uint64_t &state : The generator's state
+ * returns: The next random number
+ * note: Cheap to seed, so every game can have its own generator
+ */
+static uint64_t nextRandom(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * LaneSim
+ * purpose: Initialize a simulator for boards of the given size
+ * parameters:
+ *       int rows : Number of rows on the board
+ *       int cols : Number of columns on the board
+ *      int mines : Number of mines on the board
+ * returns: n/a
+ * note: The first move of every game is in the middle of the board
+ * expectations: The board has at least 2 rows and columns, fits in a plane,
+ *               and the mines fit outside of the free space around the first
+ *               move. CRE if violated.
+ */
+LaneSim::LaneSim(int rows, int cols, int mines)
+{
+    assert(rows > 1 and cols > 1 and rows * cols <= PLANE_BITS);
+    numRows = rows;
+    numCols = cols;
+    numMines = mines;
+    boardMask = (rows * cols == PLANE_BITS) ? ~0ULL : ((1ULL << (rows * cols)) - 1);
+
+    /* planes of the first and last columns */
+    uint64_t firstCol = 0, lastCol = 0;
+    for (int row = 0; row < rows; ++row) {
+        firstCol |= 1ULL << (row * cols);
+        lastCol |= 1ULL << ((row * cols) + cols - 1);
+    }
+
+    /* distance to each neighbor, and the cells that have that neighbor */
+    int dir = 0;
+    for (int dRow = -1; dRow <= 1; ++dRow) {
+        for (int dCol = -1; dCol <= 1; ++dCol) {
+            if ((dRow == 0) and (dCol == 0)) {
+                continue;
+            }
+            shifts[dir] = (dRow * cols) + dCol;
+            shiftMasks[dir] = boardMask;
+            if (dCol == 1) {
+                shiftMasks[dir] &= ~lastCol;
+            } else if (dCol == -1) {
+                shiftMasks[dir] &= ~firstCol;
+            }
+            ++dir;
+        }
+    }
+
+    /* cells that may have a mine (not close to the first move) */
+    int firstRow = rows / 2, firstColumn = cols / 2;
+    firstCell = (firstRow * cols) + firstColumn;
+    for (int cell = 0; cell < rows * cols; ++cell) {
+        bool close = (abs((cell / cols) - firstRow) <= SAFE_RADIUS) and (abs((cell % cols) - firstColumn) <= SAFE_RADIUS);
+        if (not close) {
+            allowed.push_back(cell);
+        }
+    }
+    assert((int)allowed.size() >= mines);
+}
+
+
+/******************************************************\
+ *                  Run Function                       *
+\******************************************************/
+
+/*
+ * run
+ * purpose: Play a range of games, keeping every lane busy until the games run
+ *          out
+ * parameters:
+ *       long first : Index of the first game
+ *       long games : Number of games to play
+ *      uint64_t seed : Seed of the whole run
+ * returns: The number of games played, won, and the guesses made
+ * note: Game i is dealt and guessed only from seed + i, so a run can be split
+ *       into ranges on different threads and the totals added together
+ */
+laneResults LaneSim::run(long first, long games, uint64_t seed)
+{
+    laneResults results = {0, 0, 0};
+    long next = first, end = first + games;
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        active[lane] = false;
+        mines[lane] = zeros[lane] = shown[lane] = flags[lane] = clicks[lane] = 0;
+        if (next < end) {
+            deal(lane, next++, seed);
+        }
+    }
+
+    bool playing = next > first;
+    while (playing) {
+
+        /* reveal the clicks of every lane */
+        bool hit[SIM_LANES];
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            hit[lane] = (clicks[lane] & mines[lane]) != 0;
+        }
+        reveal();
+
+        /* finish the games that are over and deal the next games */
+        playing = false;
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            if (not active[lane]) {
+                continue;
+            }
+            bool won = (not hit[lane]) and (shown[lane] == (boardMask & ~mines[lane]));
+            if (hit[lane] or won) {
+                ++results.games;
+                results.wins += won;
+                active[lane] = false;
+                mines[lane] = zeros[lane] = shown[lane] = flags[lane] = clicks[lane] = 0;
+                if (next < end) {
+                    deal(lane, next++, seed);
+                }
+            }
+            playing = playing or active[lane];
+        }
+
+        /* click the safe cells, or guess if nothing is certain */
+        uint64_t safe[SIM_LANES], newFlags[SIM_LANES];
+        deduce(safe, newFlags);
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            if ((not active[lane]) or (shown[lane] == 0)) {
+                continue;
+            }
+            clicks[lane] = safe[lane];
+            if ((safe[lane] == 0) and (newFlags[lane] == 0)) {
+                uint64_t unknown = boardMask & ~shown[lane] & ~flags[lane];
+                clicks[lane] = 1ULL << pickBit(unknown, random[lane]);
+                ++results.guesses;
+            }
+        }
+    }
+    return results;
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * deal
+ * purpose: Deal a new game into a lane, with the first move as its click
+ * parameters:
+ *          int lane : The lane to deal into
+ *        long index : The index of the game
+ *      uint64_t seed : Seed of the whole run
+ * returns: n/a
+ */
+void LaneSim::deal(int lane, long index, uint64_t seed)
+{
+    uint64_t state = seed + index;
+
+    /* pick the mines by shuffling the front of a copy of the allowed cells
+       (always from the same order, so the game depends only on its index) */
+    shuffled = allowed;
+    uint64_t plane = 0;
+    for (int i = 0; i < numMines; ++i) {
+        int pick = i + (nextRandom(state) % (shuffled.size() - i));
+        swap(shuffled[i], shuffled[pick]);
+        plane |= 1ULL << shuffled[i];
+    }
+
+    /* count the mines around each cell */
+    uint64_t any = 0;
+    for (int bit = 0; bit < COUNT_BITS; ++bit) {
+        number[bit][lane] = 0;
+    }
+    for (int dir = 0; dir < 8; ++dir) {
+        uint64_t carry = shift(plane, dir);
+        for (int bit = 0; bit < COUNT_BITS; ++bit) {
+            uint64_t next = number[bit][lane] & carry;
+            number[bit][lane] ^= carry;
+            carry = next;
+        }
+    }
+    for (int bit = 0; bit < COUNT_BITS; ++bit) {
+        any |= number[bit][lane];
+    }
+
+    mines[lane] = plane;
+    zeros[lane] = boardMask & ~plane & ~any;
+    shown[lane] = flags[lane] = 0;
+    clicks[lane] = 1ULL << firstCell;
+    random[lane] = state;
+    active[lane] = true;
+}
+
+/*
+ * reveal
+ * purpose: Reveal the clicked cells of every lane and open the space around
+ *          the revealed zeros
+ * parameters: n/a
+ * returns: n/a
+ * note: Clicked mines are not revealed (the caller checks for them first)
+ */
+void LaneSim::reveal()
+{
+    uint64_t grown[SIM_LANES];
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        shown[lane] |= clicks[lane] & ~mines[lane];
+    }
+
+    /* grow every lane's open space until no lane changes */
+    bool changed = true;
+    while (changed) {
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            scratch[lane] = shown[lane] & zeros[lane];
+        }
+        dilate(scratch, grown);
+        uint64_t diff = 0;
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            grown[lane] |= shown[lane];
+            diff |= grown[lane] ^ shown[lane];
+            shown[lane] = grown[lane];
+        }
+        changed = diff != 0;
+    }
+}
+
+/*
+ * deduce
+ * purpose: Flag the cells every lane's numbers prove are mines, then find the
+ *          cells they prove are safe
+ * parameters:
+ *          uint64_t *safe : Set to each lane's safe hidden cells
+ *      uint64_t *newFlags : Set to each lane's newly flagged cells
+ * returns: n/a
+ * note: A number is full if it equals its hidden neighbors (they are all 
+ *       mines) and satisfied if it equals its flagged neighbors (the rest are
+ *       safe)
+ */
+void LaneSim::deduce(uint64_t *safe, uint64_t *newFlags)
+{
+    uint64_t hidden[SIM_LANES], decided[SIM_LANES];
+
+    /* flag the hidden neighbors of full numbers */
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        hidden[lane] = boardMask & ~shown[lane];
+    }
+    count(hidden, counts);
+    equal(number, counts, decided);
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        scratch[lane] = decided[lane] & shown[lane];
+    }
+    dilate(scratch, newFlags);
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        newFlags[lane] &= hidden[lane] & ~flags[lane];
+        flags[lane] |= newFlags[lane];
+    }
+
+    /* the other hidden neighbors of satisfied numbers are safe */
+    count(flags, counts);
+    equal(number, counts, decided);
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        scratch[lane] = decided[lane] & shown[lane];
+    }
+    dilate(scratch, safe);
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        safe[lane] &= hidden[lane] & ~flags[lane];
+    }
+}
+
+/*
+ * dilate
+ * purpose: Find the cells next to a set cell in every lane
+ * parameters:
+ *      const uint64_t *plane : A plane per lane
+ *           uint64_t *result : Set to the cells next to a set cell of the 
+ *                              lane's plane
+ * returns: n/a
+ */
+void LaneSim::dilate(const uint64_t *plane, uint64_t *result)
+{
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        result[lane] = 0;
+    }
+    for (int dir = 0; dir < 8; ++dir) {
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            result[lane] |= shift(plane[lane], dir);
+        }
+    }
+}
+
+/*
+ * count
+ * purpose: Count the set neighbors of every cell in every lane
+ * parameters:
+ *                      const uint64_t *plane : A plane per lane
+ *      uint64_t result[COUNT_BITS][SIM_LANES] : Set to the counts, one plane
+ *                                               per bit of the count
+ * returns: n/a
+ */
+void LaneSim::count(const uint64_t *plane, uint64_t result[COUNT_BITS][SIM_LANES])
+{
+    for (int bit = 0; bit < COUNT_BITS; ++bit) {
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            result[bit][lane] = 0;
+        }
+    }
+
+    /* add each neighbor's plane with a ripple carry */
+    for (int dir = 0; dir < 8; ++dir) {
+        for (int lane = 0; lane < SIM_LANES; ++lane) {
+            uint64_t carry = shift(plane[lane], dir);
+            for (int bit = 0; bit < COUNT_BITS; ++bit) {
+                uint64_t next = result[bit][lane] & carry;
+                result[bit][lane] ^= carry;
+                carry = next;
+            }
+        }
+    }
+}
+
+/*
+ * equal
+ * purpose: Find the cells where two bit sliced counts are equal
+ * parameters:
+ *      uint64_t a[COUNT_BITS][SIM_LANES] : The first counts
+ *      uint64_t b[COUNT_BITS][SIM_LANES] : The second counts
+ *                       uint64_t *result : Set to the cells that are equal
+ * returns: n/a
+ */
+void LaneSim::equal(uint64_t a[COUNT_BITS][SIM_LANES], uint64_t b[COUNT_BITS][SIM_LANES], uint64_t *result)
+{
+    for (int lane = 0; lane < SIM_LANES; ++lane) {
+        uint64_t diff = 0;
+        for (int bit = 0; bit < COUNT_BITS; ++bit) {
+            diff |= a[bit][lane] ^ b[bit][lane];
+        }
+        result[lane] = ~diff;
+    }
+}
+
+/*
+ * shift
+ * purpose: Move every cell's neighbor in one direction onto the cell
+ * parameters:
+ *      uint64_t plane : A plane of cells
+ *             int dir : The direction of the neighbor (index into shifts)
+ * returns: The cells whose neighbor in that direction is set
+ */
+inline uint64_t LaneSim::shift(uint64_t plane, int dir)
+{
+    int amount = shifts[dir];
+    uint64_t moved = (amount > 0) ? (plane >> amount) : (plane << -amount);
+    return moved & shiftMasks[dir];
+}
+
+/*
+ * pickBit
+ * purpose: Pick a random set bit of a plane
+ * parameters:
+ *        uint64_t plane : A plane with at least one bit set
+ *      uint64_t &state : The lane's random state
+ * returns: The index of the bit
+ */
+int LaneSim::pickBit(uint64_t plane, uint64_t &state)
+{
+    int skip = nextRandom(state) % __builtin_popcountll(plane);
+    for (int i = 0; i < skip; ++i) {
+        plane &= plane - 1;
+    }
+    return __builtin_ctzll(plane);
+}
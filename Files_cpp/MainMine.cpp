@@ -3,24 +3,62 @@
  * Name: MainMine.cpp
  * Author: Tygan Chin
  * Purpose: Driver of the minesweeper game. Runs and reruns the game until the
- *          the user quits.
+ *          the user quits, printing the frame latency of each game.
+ * Usage: ./minesweeper [--no-guess] [--shader]
  */
 
 #include "../Files_h/Minesweeper.h"
+#include "../Files_h/BoardPool.h"
+#include "../Files_h/FirstClickTable.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
 
 /* 
  * main
  * purpose: Run and rerun the minesweeper game until the user quits or exits
  *          the game
- * parameters: n/a
+ * parameters: See usage above (--no-guess only deals boards that can be
+ *             solved without guessing, --shader draws the grid with a
+ *             shader)
  * returns: 1
  */
-int main(void)
+int main(int argc, char *argv[])
 {
+    bool noGuess = NO_GUESS_MODE;
+    bool shader = SHADER_GRID;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == NO_GUESS_FLAG) {
+            noGuess = true;
+        } else if (string(argv[i]) == SHADER_FLAG) {
+            shader = true;
+        } else {
+            cerr << "usage: ./minesweeper [" << NO_GUESS_FLAG << "] ["
+                 << SHADER_FLAG << "]" << endl;
+            return 1;
+        }
+    }
+
+    /* deal no guessing boards in the background so games start instantly */
+    BoardPool pool;
+    if (noGuess) {
+        pool.start();
+    }
+
+    /* bot win rates of every first click (the analysis skips them if missing) */
+    FirstClickTable firstClicks;
+    firstClicks.load(FIRST_CLICK_TABLE);
+
     bool play = true;
     while (play) {
-        Minesweeper mineGame;
+        Minesweeper mineGame(pool, firstClicks, noGuess, shader);
         play = mineGame.run();        
+
+        /* how long a change on the board took to reach the screen */
+        cout << "frame latency: " << fixed << setprecision(2)
+             << mineGame.averageLatency().asMicroseconds() / 1000.0 << " ms average, "
+             << mineGame.worstLatency().asMicroseconds() / 1000.0 << " ms worst" << endl;
     }
     return 1;
 }
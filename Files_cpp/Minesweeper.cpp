@@ -9,57 +9,94 @@
 #include "../Files_h/Minesweeper.h"
 #include "../Files_h/StartingMenu.h"
 #include "../Files_h/EndingMenu.h"
+#include "../Files_h/GameAnalysis.h"
 #include "../Files_h/MS_Constants.h"
 #include "../Files_h/Game_Constants.h"
 #include "../Files_h/Board.h"
+#include "../Files_h/BoardPool.h"
+#include "../Files_h/FirstClickTable.h"
+#include "../Files_h/BoardRenderer.h"
+#include "../Files_h/Timeline.h"
+#include "../Files_h/GameRecord.h"
 #include "../Files_h/SFMLhelper.h"
 #include "SFML/Graphics.hpp"
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cmath>
+#include <algorithm>
 #include <iomanip>
+#include <thread>
+#include <functional>
 #include <SFML/Audio.hpp>
 #include <SFML/Window.hpp>
 
 
 /******************************************************\
- *                    Constructor                      *
+ *                    Constructors                     *
 \******************************************************/
 
 /* 
  * Minesweeper
  * purpose: Initialize the board and and images/sounds of the minesweeper game
- * parameters: n/a
+ * parameters:
+ *           BoardPool &pool : Boards dealt ahead of time for no guessing mode
+ *      FirstClickTable &table : Bot win rates of every first click (for the
+ *                               analysis of the game)
+ *                bool noGuess : True to deal a board that needs no guessing
+ *                 bool shader : True to draw the grid with a shader (where
+ *                               shaders work)
  * returns: n/a
  */
-Minesweeper::Minesweeper()
+Minesweeper::Minesweeper(BoardPool &pool, FirstClickTable &table, bool noGuess,
+                         bool shader)
 {
     /* display starting menu to get difficulty for the game */
     StartingMenu menu;
     difficulty = menu.getDifficulty();
 
     /* initilialize game with differenet values depending on the difficulty */
-    if (difficulty == EASY) {
-        gameBoard.setBoard(EASY_COLS, EASY_ROWS, EASY_BOMBS);  
-        windowScaler = EASY_SCALE;   
-        windowWidth = WIDTH;
-        cellScaler = (HEIGHT - TITLE_HEIGHT) / EASY_ROWS;
-    } else if (difficulty == MEDIUM) {
-        gameBoard.setBoard(MEDIUM_COLS, MEDIUM_ROWS, MEDIUM_BOMBS);
-        windowScaler = MED_SCALE;
-        windowWidth = MED_WIDTH;
-        cellScaler = ((HEIGHT - TITLE_HEIGHT) / MEDIUM_ROWS) - MED_OFFSET; 
-    } else if (difficulty == HARD) {
-        gameBoard.setBoard(HARD_COLS, HARD_ROWS, HARD_BOMBS);   
-        windowScaler = HARD_SCALE;
-        windowWidth = HARD_WIDTH;
-        cellScaler = ((HEIGHT - TITLE_HEIGHT) / HARD_ROWS) - HARD_OFFSET;     
-    } else {
-        exit(1);
-    }
+    setDifficulty();
+
+    /* deal a board that needs no guessing if the mode is on */
+    gameBoard.setNoGuess(noGuess);
+    gameBoard.setPool(&pool);
+    pool.setPriority(difficulty);
+    firstClicks = &table;
 
     /* set the images and sounds */
+    shaderGrid = shader;
     setImagesAndAudio();
+    rendering = false;
+    latencyTotal = latencyWorst = Time::Zero;
+    latencyFrames = 0;
+}
+
+/*
+ * Minesweeper
+ * purpose: Initialize the images of the game only, to draw boards off screen
+ *          with drawBoard
+ * parameters:
+ *      int level : The difficulty (EASY, MEDIUM or HARD)
+ * returns: n/a
+ * note: No window, menu or sound is used, but drawing still needs an OpenGL
+ *       context (a virtual display on machines without one). run must not be
+ *       called.
+ */
+Minesweeper::Minesweeper(int level)
+{
+    difficulty = level;
+    setDifficulty();
+    firstClicks = NULL;
+    shaderGrid = SHADER_GRID;
+
+    /* set the images (the mines are drawn as in a lost game) */
+    setImages();
+    grid.setMine(false, RED);
+    grid.setWaiting(true);
+    rendering = false;
+    latencyTotal = latencyWorst = Time::Zero;
+    latencyFrames = 0;
 }
 
 
@@ -79,15 +116,99 @@ bool Minesweeper::run()
     RW window(VideoMode(windowWidth, HEIGHT), WINDOW_NAME);
     window.setFramerateLimit(FRAMERATE_LIMIT);
 
-    /* run game */
+    /* run game and save it to be replayed (once the board was dealt) */
     Time time = runGame(window);
+    if (not gameBoard.getMoves().empty()) {
+        record.save(RECORD_FILE);
+    }
     
+    /* analyze the user's moves in the background while the menu is shown */
+    GameAnalysis analysis(gameBoard, *firstClicks, difficulty);
+    analysis.start();
+
     /* display ending menu and return whether user wants to play again */
-    EndingMenu end(gameBoard.won(), time, difficulty);
+    EndingMenu end(gameBoard.won(), time, difficulty, analysis);
     return end.playAgain();
 }
 
 
+/******************************************************\
+ *                  Latency Getters                    *
+\******************************************************/
+
+/*
+ * averageLatency
+ * purpose: Returns how long a snapshot of the last game took on average from
+ *          being published to being on screen
+ * parameters: n/a
+ * returns: The average frame latency (Time::Zero before a game is played)
+ */
+Time Minesweeper::averageLatency()
+{
+    if (latencyFrames == 0) {
+        return Time::Zero;
+    }
+    return microseconds(latencyTotal.asMicroseconds() / latencyFrames);
+}
+
+/*
+ * worstLatency
+ * purpose: Returns the longest a snapshot of the last game took from being
+ *          published to being on screen
+ * parameters: n/a
+ * returns: The worst frame latency (Time::Zero before a game is played)
+ */
+Time Minesweeper::worstLatency()
+{
+    return latencyWorst;
+}
+
+
+/******************************************************\
+ *                Off Screen Drawing                   *
+\******************************************************/
+
+/*
+ * frameSize
+ * purpose: Returns the size of a frame of the game
+ * parameters: n/a
+ * returns: The size of the game's window, in pixels
+ */
+Vector2u Minesweeper::frameSize()
+{
+    return Vector2u(windowWidth, HEIGHT);
+}
+
+/*
+ * drawBoard
+ * purpose: Draw a frame of the game for the given board on any render target
+ *          (a render texture to save it as an image)
+ * parameters:
+ *      RenderTarget &target : Where to draw the frame (frameSize pixels)
+ *              Board &board : The board to draw (its change log is emptied)
+ *             Time currTime : The time shown in the title bar
+ * returns: n/a
+ * expectations: The board has this game's difficulty and the render thread
+ *               isn't running
+ * note: Every cell is drawn as the board is now, even if the last board drawn
+ *       was another one. The caller displays the target.
+ */
+void Minesweeper::drawBoard(RenderTarget &target, Board &board, Time currTime)
+{
+    /* start the grid over, so no opening is left half drawn */
+    float thickness = cellScaler / CELL_THICKNESS_SCALER;
+    grid.setBoard(board.getNumRows(), board.getNumCols(), cellScaler, Vector2f(0, 0), thickness);
+
+    snapshots.restart();
+    snapshots.capture(board);
+    snapshots.back().time = currTime;
+    snapshots.back().view = boardView;
+    snapshots.publish();
+    snapshots.take();
+    drawFrame(target, snapshots.front(), currTime);
+}
+
+
 /******************************************************\
  *               Game Helper Functions                 *
 \******************************************************/
@@ -98,64 +219,145 @@ bool Minesweeper::run()
  * parameters: 
  *      RW &window : Render window the game is played on
  * returns: The time elasped during the game
- * note: The program will exit if user exits the window
+ * note: The program will exit if user exits the window. The game is drawn
+ *       on its own thread (see renderLoop) from the snapshots published
+ *       here, so a slow move never holds up a frame and a slow frame never
+ *       holds up input.
  */
 Time Minesweeper::runGame(RW &window)
 {
-    /* continue to print board until user wins/loses the game */
+    /* hand the window's drawing to the render thread */
     Clock time;
     bool bombHit = false;
-    while ((window.isOpen()) and (not bombHit) and (not gameBoard.won()))
+    record.start(difficulty);
+    latencyTotal = latencyWorst = Time::Zero;
+    latencyFrames = 0;
+    publish(time.getElapsedTime());
+    window.setActive(false);
+    rendering = true;
+    thread renderer(&Minesweeper::renderLoop, this, ref(window));
+
+    /* continue to play until user wins/loses the game */
+    Event event;
+    while ((window.isOpen()) and (not bombHit) and (not gameBoard.won()) and (window.waitEvent(event)))
     {
-        /* draw the board */
-        drawGame(window, time.getElapsedTime());
-
         /* respond to user input */
-        Event event;
-        while (window.pollEvent(event))
-        {
+        bool changed = false;
+        do {
             /* exit window, reveal cell, place flag, or nothing */
             if (event.type == Event::Closed) {
+                rendering = false;
+                snapshots.wake();
+                renderer.join();
                 window.close();   
                 exit(1);        
             } else if (SFML.leftClick(event)) {
-                bombHit = gameMove(window);
+                bombHit = gameMove(window, time.getElapsedTime());
+                changed = true;
             } else if (SFML.SpacebarPressed(event)) {
-                placeFlag(window);
+                placeFlag(window, time.getElapsedTime());
+                changed = true;
+            } else if ((moveCamera(window, event)) or (SFML.needsRedraw(event))) {
+                changed = true;
             }
+        } while ((not bombHit) and (window.pollEvent(event)));
+
+        /* show the render thread the new board */
+        if (changed) {
+            publish(time.getElapsedTime());
         }
     }
 
-    /* end animation */
+    /* take the drawing back for the end animation */
     Time currTime = time.getElapsedTime();
+    record.finish(currTime.asMilliseconds(), gameBoard.getMines());
+    rendering = false;
+    snapshots.wake();
+    renderer.join();
+    window.setActive(true);
     endAnimation(window, currTime);
 
     /* return elapsed time as a string */
     return currTime;
 }
 
+/*
+ * renderLoop
+ * purpose: Draw the game whenever a new snapshot is published, the timer
+ *          ticks or an opening is still being drawn, until runGame stops it
+ * parameters:
+ *      RW &window : Render window the game is played on
+ * returns: n/a
+ * note: Runs on the render thread, which owns the window's drawing and the
+ *       grid while it runs. Sleeps until the next snapshot or clock tick when
+ *       there is nothing to draw. Records how long each snapshot took from
+ *       being published to being on screen.
+ */
+void Minesweeper::renderLoop(RW &window)
+{
+    window.setActive(true);
+    int drawnSecond = -1;
+    while (rendering) {
+
+        /* the latest board, and the game time now */
+        bool fresh = snapshots.take();
+        const BoardSnapshot &shot = snapshots.front();
+        Time now = shot.time + shot.published.getElapsedTime();
+        int second = now.asSeconds();
+        if ((not fresh) and (second == drawnSecond) and (not grid.revealing())) {
+            snapshots.wait(seconds(second + 1) - now);
+            continue;
+        }
+
+        drawFrame(window, shot, now);
+        window.display();
+        drawnSecond = second;
+        if (fresh) {
+            Time latency = shot.published.getElapsedTime();
+            latencyTotal += latency;
+            latencyWorst = max(latencyWorst, latency);
+            ++latencyFrames;
+        }
+    }
+    window.setActive(false);
+}
+
+/*
+ * publish
+ * purpose: Publish a snapshot of the board, the view of it and the time for
+ *          the render thread
+ * parameters:
+ *      Time time : The time elapsed during the game
+ * returns: n/a
+ */
+void Minesweeper::publish(Time time)
+{
+    snapshots.capture(gameBoard);
+    snapshots.back().time = time;
+    snapshots.back().view = boardView;
+    snapshots.publish();
+}
+
 /* 
  * gameMove
  * purpose: Reveal the cell the user clicked on (if valid) and play the 
  *          correspondingsound
  * parameters:
- *      RW &window : Render window the game is played on
+ *       RW &window : Render window the game is played on
+ *      Time moment : The time elapsed during the game (for the record)
  * returns: True if a mine wasn't hit, false otherwise
  */
-bool Minesweeper::gameMove(RW &window)
+bool Minesweeper::gameMove(RW &window, Time moment)
 {
-    /* get the position of the mouse */
-    Vector2i mousePos = Mouse::getPosition(window);
-
-    /* check if the mouse postiion is on the board */
-    if (invalidCell(mousePos)) {
+    /* find the cell under the mouse (if it's on the board) */
+    int cell_Row, cell_Col;
+    if (not findCell(window, cell_Row, cell_Col)) {
         return false ;
     }
 
     /* make move on board */
-    int cell_Row = mousePos.y / cellScaler - (TITLE_HEIGHT / cellScaler);
-    int cell_Col = mousePos.x / cellScaler;
     int gameState = gameBoard.move(cell_Row, cell_Col);
+    record.add(moment.asMilliseconds(), false, cell_Row, cell_Col);
 
     /* play corresponding sound to gameState and return true if mine was hit */
     if (gameState == NUMBERED_SPACE) {
@@ -174,83 +376,181 @@ bool Minesweeper::gameMove(RW &window)
  * purpose: Place a flag on the cell corresponding to the user's cursor 
  *          (if applicable) and play the corresponding sound.
  * parameters:
- *      RW &window : Render window the game is played on
+ *       RW &window : Render window the game is played on
+ *      Time moment : The time elapsed during the game (for the record)
  * returns: n/a
  * effects: A flag is set to be drawn on the selected cell
  */
-void Minesweeper::placeFlag(RW &window)
+void Minesweeper::placeFlag(RW &window, Time moment)
 {
-    /* get the current mouse postion */
-    Vector2i mousePos = Mouse::getPosition(window);
-
-    /* check if the mouse postiion is on the board */
-    if (invalidCell(mousePos)) {
+    /* find the cell under the mouse (if it's on the board) */
+    int cell_Row, cell_Col;
+    if (not findCell(window, cell_Row, cell_Col)) {
         return;
     }
 
     /* place flag */
-    int cell_Row = (mousePos.y / cellScaler) - (TITLE_HEIGHT / cellScaler);
-    int cell_Col = (mousePos.x / cellScaler);
     bool flagPlaced = gameBoard.placeFlag(cell_Row, cell_Col);
 
-    /* play flag noise if flag was placed succssfully */
+    /* play flag noise and record the flag if it was placed succssfully */
     if (flagPlaced) {
         flag_sound.play();
+        record.add(moment.asMilliseconds(), true, cell_Row, cell_Col);
     }
 }
 
-/* 
- * invalidCell
- * purpose: Determine whether the given mouse position is on a cell
+/*
+ * findCell
+ * purpose: Find the cell under the mouse, through the board's view
  * parameters:
- *      Vector 2i &mousePos : The postition of the mouse on the render window
- * returns: True if the cursor is not on a valid cell, false otherwise
+ *      RW &window : Render window the game is played on
+ *        int &row : Set to the row of the cell
+ *        int &col : Set to the column of the cell
+ * returns: True if the mouse is on a cell, false otherwise
  */
-bool Minesweeper::invalidCell(Vector2i &mousePos)
+bool Minesweeper::findCell(RW &window, int &row, int &col)
 {
-    /* get the height and width of the board displayed on the screen */
-    int boardHeight = (cellScaler * gameBoard.getNumRows()) + TITLE_HEIGHT;
-    int boardWidth  = (cellScaler * gameBoard.getNumCols());
-
-    /* return whether the mouse position is on the board */
-    bool invalidRow = (mousePos.y < TITLE_HEIGHT or mousePos.y > boardHeight);
-    bool invalidCol = (mousePos.x < 0 or mousePos.x > boardWidth);
-    return (invalidRow or invalidCol);
+    /* the mouse can't be on a cell while it's on the title */
+    Vector2i mousePos = Mouse::getPosition(window);
+    if (mousePos.y < TITLE_HEIGHT) {
+        return false;
+    }
+
+    /* find the point on the board under the mouse */
+    Vector2f point = window.mapPixelToCoords(mousePos, boardView);
+    if ((point.x < 0) or (point.y < 0)) {
+        return false;
+    }
+    row = point.y / cellScaler;
+    col = point.x / cellScaler;
+    return (row < gameBoard.getNumRows()) and (col < gameBoard.getNumCols());
 }
 
 /* 
  * drawGame
- * purpose: Draw the board on the given render window
+ * purpose: Draw the board on the given render window from this thread
  * parameters: The game render window and the current elapsed time
  *      RW &window : Render window the game is played on
  *       Time time : The time elapsed during the game
  * returns: n/a
  * Effect: An updated version of the board is drawn to the window
+ * note: Only while the render thread isn't running (this thread publishes
+ *       the snapshot and takes it)
  */
 void Minesweeper::drawGame(RW &window, Time currTime)
+{
+    publish(currTime);
+    snapshots.take();
+    drawFrame(window, snapshots.front(), currTime);
+    window.display();
+}
+
+/*
+ * drawFrame
+ * purpose: Draw a snapshot of the game on the given render target
+ * parameters:
+ *           RenderTarget &target : The game's window or an off screen
+ *                                  texture
+ *      const BoardSnapshot &shot : The board, its view and the flags left
+ *                  Time currTime : The time elapsed during the game
+ * returns: n/a
+ * note: The caller displays the target
+ */
+void Minesweeper::drawFrame(RenderTarget &target, const BoardSnapshot &shot, Time currTime)
 {
     /* clear the window */
-    window.clear(WHITE);
+    target.clear(WHITE);
 
-    /* draw the title */
-    SFML.drawTextBox(window, title);
+    /* draw the title and title flag */
+    target.draw(titleSprite);
 
     /* draw the time */
     string currTimeString = SFML.getTime(currTime);
     SFML.setString(currTimeString, time.text, time.box);
-    SFML.drawTextBox(window, time);
+    SFML.drawTextBox(target, time);
 
     /* draw flag and flag count */
-    string currNumFlags = to_string(gameBoard.numFlags());
+    string currNumFlags = to_string(shot.flagsLeft);
     SFML.setString(currNumFlags, flag_amount.text, flag_amount.box);
-    window.draw(flag_in_title);
-    SFML.drawTextBox(window, flag_amount);
+    SFML.drawTextBox(target, flag_amount);
 
     /* draw grid */
-    drawGrid(window);
+    drawGrid(target, shot);
+}
 
-    /* display the window */
-    window.display();
+
+/******************************************************\
+ *                 Camera Functions                    *
+\******************************************************/
+
+/*
+ * moveCamera
+ * purpose: Zoom the board with the mouse wheel and pan it by dragging with
+ *          the right mouse button or with the arrow keys
+ * parameters:
+ *       RW &window : Render window the game is played on
+ *      Event event : The window event
+ * returns: True if the view of the board changed, false otherwise
+ */
+bool Minesweeper::moveCamera(RW &window, Event event)
+{
+    if (event.type == Event::MouseWheelScrolled) {
+
+        /* zoom keeping the point under the mouse in place */
+        Vector2i mousePos(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+        Vector2f before = window.mapPixelToCoords(mousePos, boardView);
+        float factor = pow(ZOOM_STEP, -event.mouseWheelScroll.delta);
+        float zoom = min(MAX_ZOOM, max(1.0f, boardSize.x / (boardView.getSize().x * factor)));
+        boardView.setSize(boardSize.x / zoom, boardSize.y / zoom);
+        Vector2f after = window.mapPixelToCoords(mousePos, boardView);
+        boardView.move(before.x - after.x, before.y - after.y);
+
+    } else if ((event.type == Event::MouseButtonPressed) and (event.mouseButton.button == Mouse::Right)) {
+        panning = true;
+        panFrom = Vector2i(event.mouseButton.x, event.mouseButton.y);
+        return false;
+
+    } else if ((event.type == Event::MouseButtonReleased) and (event.mouseButton.button == Mouse::Right)) {
+        panning = false;
+        return false;
+
+    } else if ((event.type == Event::MouseMoved) and (panning)) {
+
+        /* move the board with the mouse */
+        Vector2i mousePos(event.mouseMove.x, event.mouseMove.y);
+        Vector2f from = window.mapPixelToCoords(panFrom, boardView);
+        Vector2f to = window.mapPixelToCoords(mousePos, boardView);
+        boardView.move(from.x - to.x, from.y - to.y);
+        panFrom = mousePos;
+
+    } else if (event.type == Event::KeyPressed) {
+
+        /* move the board a step with the arrow keys */
+        Vector2f step = boardView.getSize() * PAN_STEP;
+        Keyboard::Key key = event.key.code;
+        if (key == Keyboard::Left) {
+            boardView.move(-step.x, 0);
+        } else if (key == Keyboard::Right) {
+            boardView.move(step.x, 0);
+        } else if (key == Keyboard::Up) {
+            boardView.move(0, -step.y);
+        } else if (key == Keyboard::Down) {
+            boardView.move(0, step.y);
+        } else {
+            return false;
+        }
+
+    } else {
+        return false;
+    }
+
+    /* keep the view on the board */
+    Vector2f size = boardView.getSize();
+    Vector2f center = boardView.getCenter();
+    center.x = min(max(center.x, size.x / 2), boardSize.x - (size.x / 2));
+    center.y = min(max(center.y, size.y / 2), boardSize.y - (size.y / 2));
+    boardView.setCenter(center);
+    return true;
 }
 
 
@@ -267,111 +567,126 @@ void Minesweeper::drawGame(RW &window, Time currTime)
  *      RW &window : Render window the game is played on
  *       Time time : Time object containing the time elasped during the game
  * returns: n/a
- * note: The animation can be skipped by clicking anywhere on the screen
+ * note: The animation can be skipped by clicking anywhere on the screen, and
+ *       plays FAST_FORWARD times faster while the space bar is held. Between
+ *       mines the window sleeps until the next one is due or an event comes.
  */
 void Minesweeper::endAnimation(RW &window, Time time)
 {
     /* set animation to either winning or losing */
-    int currDelay = END_ANIMATION_DELAY;
     setAnimationImages();
 
-    /* reveal first mine (no delay) */
-    bool mineRevealed = reveal(window, time);
-    
-    /* reveal the mines 1 by 1 after each delay */
-    Clock clock;
-    while ((window.isOpen()) and (mineRevealed))
-    {
-        /* start delay */
-        Time delay = milliseconds(currDelay);
+    /* schedule the mines 1 by 1, each delay shorter than the last, then a
+       pause before the window closes */
+    Timeline timeline;
+    bool mineRevealed = false;
+    int currDelay = END_ANIMATION_DELAY;
+    Time when = Time::Zero;
+    for (int i = 0; i < gameBoard.getNumBombs(); ++i) {
+        timeline.at(when, [this, &mineRevealed]() { mineRevealed = gameBoard.revealMine() or mineRevealed; });
+        when += milliseconds(currDelay);
+        currDelay = max(MIN_DELAY, currDelay - DELAY_DECREMENT);
+    }
+    timeline.at(when + seconds(BUTTON_DELAY), []() {});
 
-        /* check if user exited window / exited the animation */
-        Event event;
-        if (windowExit(window, event)) {
-            window.close();
-            return;
+    bool changed = true;
+    while ((window.isOpen()) and (not timeline.done()))
+    {
+        /* reveal the mines that are due (one sound per frame) */
+        mineRevealed = false;
+        timeline.update();
+        if (mineRevealed) {
+            cellReveal.play();
+            changed = true;
+        }
+        if ((changed) or (grid.revealing())) {
+            drawGame(window, time);
+            changed = false;
         }
 
-        /*  Check if the desired delay has passed */
-        if ((clock.getElapsedTime() >= delay)) {
-
-            /* reveal mine */
-            mineRevealed = reveal(window, time);
-
-            /* update delay and restart clock */
-            currDelay = max(MIN_DELAY, currDelay - DELAY_DECREMENT);
-            clock.restart();
+        /* sleep until the next mine is due, unless the user does something */
+        Event event;
+        Time timeout = grid.revealing() ? Time::Zero : timeline.untilNext();
+        if (not SFML.waitEvent(window, event, timeout)) {
+            continue;
         }
+        do {
+            /* exit program, skip, fast forward or redraw */
+            if (event.type == Event::Closed) {
+                window.close();
+                exit(1);
+            } else if (SFML.leftClick(event)) {
+                timeline.skip();
+            } else if (SFML.SpacebarPressed(event)) {
+                timeline.setSpeed(FAST_FORWARD);
+            } else if (SFML.SpacebarReleased(event)) {
+                timeline.setSpeed(1);
+            } else if (SFML.needsRedraw(event)) {
+                changed = true;
+            }
+        } while (window.pollEvent(event));
     }
 
-    sleep(seconds(BUTTON_DELAY));
     window.close();
 }
 
-/* 
- * windowExit
- * purpose: Check if the window is clicked by the user which means they would 
- *          like to exit
- * parameters:
- *       RW &window : Render window the game is played on
- *      Event event : The window event
- * returns: True if the user clicked and would like to exit the end animation
- *          false otherwise.
- * note: If the user exists the window itself the program exits.
- */
-bool Minesweeper::windowExit(RW &window, Event event)
-{
-    while (window.pollEvent(event)) {
 
-        /* exit program if window is closed */
-        if (event.type == Event::Closed) {
-            window.close();
-            exit(1);
-        }
+/******************************************************\
+ *                 Set Image Functions                 *
+\******************************************************/
 
-        /* end animation if screen is clicked */
-        if (SFML.leftClick(event)) {
-            return true;
-        }
+/*
+ * setDifficulty
+ * purpose: Set the board, window width and scalers of the difficulty
+ * parameters: n/a
+ * returns: n/a
+ * note: The program exits if the difficulty isn't EASY, MEDIUM or HARD
+ */
+void Minesweeper::setDifficulty()
+{
+    if (difficulty == EASY) {
+        gameBoard.setBoard(EASY_COLS, EASY_ROWS, EASY_BOMBS);  
+        windowScaler = EASY_SCALE;   
+        windowWidth = WIDTH;
+        cellScaler = (HEIGHT - TITLE_HEIGHT) / EASY_ROWS;
+    } else if (difficulty == MEDIUM) {
+        gameBoard.setBoard(MEDIUM_COLS, MEDIUM_ROWS, MEDIUM_BOMBS);
+        windowScaler = MED_SCALE;
+        windowWidth = MED_WIDTH;
+        cellScaler = ((HEIGHT - TITLE_HEIGHT) / MEDIUM_ROWS) - MED_OFFSET; 
+    } else if (difficulty == HARD) {
+        gameBoard.setBoard(HARD_COLS, HARD_ROWS, HARD_BOMBS);   
+        windowScaler = HARD_SCALE;
+        windowWidth = HARD_WIDTH;
+        cellScaler = ((HEIGHT - TITLE_HEIGHT) / HARD_ROWS) - HARD_OFFSET;     
+    } else {
+        exit(1);
     }
-
-    return false;
 }
 
 /* 
- * reveal
- * purpose: Reveal another mine and draw the board/play sound
- * parameters: 
- *      RW &window : Render window the game is played on
- *       Time time : The time elapsed during the game
- * returns: True if the mine was revealed, false if there were no mines left 
- *          to reveal.
+ * setImagesAndAudio
+ * purpose: Initialize the images to be drawn on the screen and the sounds
+ * parameters: n/a
+ * returns: n/a
  */
-bool Minesweeper::reveal(RW &window, Time time)
+void Minesweeper::setImagesAndAudio()
 {
-    /* return true if all mines have been revealed */
-    if (not gameBoard.revealMine()) {
-        return false; 
-    }
-    
-    /* draw window with the new mine revealed */
-    drawGame(window, time);
-    cellReveal.play();
-    return true;
-}
+    setImages();
 
-
-/******************************************************\
- *                 Set Image Functions                 *
-\******************************************************/
+    /* set the sound effects */
+    click_sound     = SFML.setSound(CLICK_SOUND);
+    openSpace_sound = SFML.setSound(OPEN_SPACE_SOUND);
+    flag_sound      = SFML.setSound(FLAG_SOUND);
+}
 
 /* 
- * setImagesAndAudio
+ * setImages
  * purpose: Initialize the images to be drawn on the screen 
  * parameters: n/a
  * returns: n/a
  */
-void Minesweeper::setImagesAndAudio()
+void Minesweeper::setImages()
 {
     /* set title */
     rectangleInfo titleBox = TITLE_BOX;
@@ -386,16 +701,12 @@ void Minesweeper::setImagesAndAudio()
 
     /* set flag image and count */
     setFlags();
+    setTitleLayer();
 
     /* set the grid images */
     setCellBox();
     setCellText_numbers();
     setCellText_flags();
-
-    /* set the sound effects */
-    click_sound     = SFML.setSound(CLICK_SOUND);
-    openSpace_sound = SFML.setSound(OPEN_SPACE_SOUND);
-    flag_sound      = SFML.setSound(FLAG_SOUND);
 }
 
 /* 
@@ -420,33 +731,43 @@ void Minesweeper::setFlags()
     flag_amount = SFML.makeTextBox(flagTopBox, FLAG_COUNT_TEXT);
 }
 
+/*
+ * setTitleLayer
+ * purpose: Draw the parts of the title bar that never change (the title and
+ *          the flag image) once, so each frame only draws the time and count
+ * parameters: n/a
+ * returns: n/a
+ */
+void Minesweeper::setTitleLayer()
+{
+    titleLayer.create(windowWidth, TITLE_HEIGHT);
+    titleLayer.clear(WHITE);
+    SFML.drawTextBox(titleLayer, title);
+    titleLayer.draw(flag_in_title);
+    titleLayer.display();
+    titleSprite.setTexture(titleLayer.getTexture(), true);
+}
+
 /*
  * setCellBox
- * purpose: Set the revealed and hidden cell boxes
+ * purpose: Set the size, position and colors of the revealed and hidden cells
+ *          (drawn by the shader when it was asked for and shaders work) and
+ *          the view they are drawn through
  * parameters: n/a
  * returns: n/a
  */
 void Minesweeper::setCellBox()
 {
-    /* set dimensions and outline thickess of the cell */
-    int width       = cellScaler;
-    int height      = cellScaler;
     float thickness = cellScaler / CELL_THICKNESS_SCALER;
-
-    /* set the rectangle info for the shown and hidden cells */
-    rectangleInfo shown  = CELL_BOX;
-    rectangleInfo hidden = CELL_BOX;
-    shown.width     = hidden.width     = width;
-    shown.height    = hidden.height    = height;
-    shown.thickness = hidden.thickness = thickness;
-
-    /* update the colors based */
-    shown.fill  = SHOWN_CELL_COLOR;
-    hidden.fill = NOT_SHOWN_CELL_COLOR;
-    
-    /* create text boxes for each */
-    shown_cell_box     = SFML.createRec(shown);
-    not_shown_cell_box = SFML.createRec(hidden);
+    grid.setBoard(gameBoard.getNumRows(), gameBoard.getNumCols(), cellScaler, Vector2f(0, 0), thickness);
+
+    /* show the whole board below the title, zoomed out all the way */
+    boardSize = Vector2f(windowWidth, HEIGHT - TITLE_HEIGHT);
+    boardView.reset(FloatRect(0, 0, boardSize.x, boardSize.y));
+    boardView.setViewport(FloatRect(0, TITLE_HEIGHT / HEIGHT, 1, boardSize.y / HEIGHT));
+    panning = false;
+    grid.setCellColors(NOT_SHOWN_CELL_COLOR, SHOWN_CELL_COLOR, CELL_BOX.outline);
+    grid.setShader(shaderGrid);
 }
 
 /*
@@ -464,21 +785,18 @@ void Minesweeper::setCellText_numbers()
         currNumber.fill = COLORS[i];
         cellNums[i] = SFML.createText(currNumber);
     }
+    grid.setDigits(cellNums);
 }
 
 /*
  * setCellText_flags
- * purpose: Set the flag images that go inside of the cells
+ * purpose: Set the flag and mine images that go inside of the cells
  * parameters: n/a
  * returns: n/a
  */
 void Minesweeper::setCellText_flags()
 {
-    /* set flag sprite */
-    spriteInfo flag = FLAG_CELL_BOX;
-    flag.width = cellScaler * CELL_IMAGE_SCALE;
-    flag.height = cellScaler * CELL_IMAGE_SCALE;
-    cell_flag = SFML.setSprite(flag);
+    grid.setImages(FLAG_CELL_BOX.file, WIN_IMAGE, LOSS_IMAGE, CELL_IMAGE_SCALE);
 }
 
 /* 
@@ -490,20 +808,15 @@ void Minesweeper::setCellText_flags()
 void Minesweeper::setAnimationImages()
 {
     /* set cell and cell reveal sound */
-    int imgWidth = cellScaler * CELL_IMAGE_SCALE;
-    int imgHeight = cellScaler * CELL_IMAGE_SCALE;
-    float thickness = cellScaler / CELL_THICKNESS_SCALER;
     if (gameBoard.won()) {
 
         cellReveal = SFML.setSound(EFFECT_WON);
-        end_animation_cell = SFML.createRec(cellScaler, cellScaler, 0, 0, GREEN, thickness, BLACK);
-        end_animation_image = SFML.setSprite(WIN_IMAGE, imgWidth, imgHeight, 0, 0);
+        grid.setMine(true, GREEN);
 
     } else {
 
         cellReveal = SFML.setSound(EFFECT_LOST);
-        end_animation_cell = SFML.createRec(cellScaler, cellScaler, 0, 0, RED, thickness, BLACK);
-        end_animation_image = SFML.setSprite(LOSS_IMAGE, imgWidth, imgHeight, 0, 0);
+        grid.setMine(false, RED);
     }
 }
 
@@ -516,120 +829,17 @@ void Minesweeper::setAnimationImages()
  * drawGrid
  * purpose: Draw the grid of cells for the minesweeper game 
  * parameters:
- *      RW &window : Render window the game is played on
+ *           RenderTarget &target : The game's window or an off screen
+ *                                  texture
+ *      const BoardSnapshot &shot : The board and its view
  * returns: n/a
+ * note: Only the cells that changed since the last frame are rewritten, and
+ *       the whole grid is drawn in one call per layer (see BoardRenderer)
  */
-void Minesweeper::drawGrid(RW &window)
+void Minesweeper::drawGrid(RenderTarget &target, const BoardSnapshot &shot)
 {
-    /* iterate through board drawing each cell */
-    for (int row = 0; row < gameBoard.getNumRows(); ++row) {
-        for (int col = 0; col < gameBoard.getNumCols(); ++col) {
-            drawCell(window, row, col);  
-        }
-    }
-}
-
-/*
- * drawCell
- * purpose: Draw a single cell on the board
- * parameters:
- *      RW &window : Render window the game is played on
- *        int &row : Row of the cell on the board
- *        int &col : Column of the cell on the board
- * returns: n/a
- */
-void Minesweeper::drawCell(RW &window, int &row, int &col)
-{
-    /* calcualte the cell's position */
-    int cell_xPos = cellScaler * col;
-    int cell_yPos = (cellScaler * row) + TITLE_HEIGHT;
-
-    /* draw the cell */
-    if (gameBoard.isShown(row, col)) {
-
-        if (gameBoard.getNumber(row, col) != MINE) {
-            /* draw cell box */
-            shown_cell_box.setPosition(cell_xPos, cell_yPos);
-            window.draw(shown_cell_box);
-            
-            /* draw the insides of the cell */
-            drawOpenCell(window, shown_cell_box, row, col);            
-        } else {
-            /* draw cell box */
-            end_animation_cell.setPosition(cell_xPos, cell_yPos);
-            window.draw(end_animation_cell);
-            
-            /* draw the insides of the cell */
-            drawOpenCell(window, end_animation_cell, row, col); 
-        }
-    } else {
-
-        /* draw cell box */
-        not_shown_cell_box.setPosition(cell_xPos, cell_yPos);
-        window.draw(not_shown_cell_box);
-
-        /* draw the insides of the cell */
-        drawCellFlag(window, not_shown_cell_box, row, col);
-
-    }
-}
-
-/*
- * drawOpenCell
- * purpose: Draw a cell that has been revealed
- * parameters: 
- *           RW &window : Render window the game is played on
- *      Rectangle &cell : The drawing of the cell at the row and column
- *             int &row : Row of the cell on the board
- *             int &col : Column of the cell on the board
- * returns: n/a
- */
-void Minesweeper::drawOpenCell(RW &window, Rectangle &cell, int &row, int &col)
-{
-    /* get cell value */
-    int cellVal = (gameBoard.getNumber(row, col));
-
-    /* draw the number in the cell or the bomb animation image */
-    if (cellVal > 0) {
-
-        Text currNumber = cellNums[cellVal - 1];
-        SFML.centerText(currNumber, cell);
-        window.draw(currNumber);
-
-    } else if (cellVal == MINE) {
-
-        float offset = ((cellScaler - (cellScaler * CELL_IMAGE_SCALE)) / 2);
-        float xPos = cell.getPosition().x + offset;
-        float yPos = cell.getPosition().y + offset;
-        end_animation_image.setPosition(xPos, yPos);
-        window.draw(end_animation_image);
-
-    }
-}
-
-/*
- * drawCellFlag
- * purpose: Draw a flag on the hidden cell if necessary
- * parameters: n/a
- *           RW &window : Render window the game is played on
- *      Rectangle &cell : The drawing of the cell at the row and column
- *             int &row : Row of the cell on the board
- *             int &col : Column of the cell on the board
- * returns: n/a
- */
-void Minesweeper::drawCellFlag(RW &window, Rectangle &cell, int &row, int &col)
-{
-    /* return if no flag exists */
-    if (not gameBoard.isFlag(row, col)) {
-        return;
-    }
-
-    /* set the postion of the cell flag image */
-    float offset = ((cellScaler - (cellScaler * CELL_IMAGE_SCALE)) / 2);
-    float xPos = cell.getPosition().x + offset;
-    float yPos = cell.getPosition().y + offset;
-    cell_flag.setPosition(xPos, yPos);
-
-    /* draw the cell flag */
-    window.draw(cell_flag);
+    target.setView(shot.view);
+    grid.update(target, shot);
+    grid.draw(target);
+    target.setView(target.getDefaultView());
 }
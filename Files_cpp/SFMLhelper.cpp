@@ -13,6 +13,7 @@
 #include <iomanip>
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include "../Files_h/SFMLhelper.h"
 #include "SFML/Graphics.hpp"
 #include "SFML/Audio.hpp"
@@ -64,14 +65,14 @@ textBox SFMLhelper::makeTextBox(rectangleInfo rectangleData, textInfo textData)
 
 /*
  * drawTextBox
- * Purpose: Draw the text box onto the given renderWindow
+ * Purpose: Draw the text box onto the given window or texture
  * Parameters: 
- *      RenderWindow &window : The window on the user's screen
+ *      RenderTarget &window : The window on the user's screen (or a texture)
  *              textBox &box : A textBox struct containing a RectangleShape
  *                             and a Text object
  * Returns: n/a
  */
-void SFMLhelper::drawTextBox(RenderWindow &window, textBox &tBox)
+void SFMLhelper::drawTextBox(RenderTarget &window, textBox &tBox)
 {
     window.draw(tBox.box);
     window.draw(tBox.text);
@@ -345,6 +346,56 @@ bool SFMLhelper::SpacebarPressed(Event event)
             and (event.key.code == Keyboard::Space);
 }
 
+/*
+ * SpacebarReleased
+ * Purpose: Determines whether the space bar was let go of
+ * Parameters:
+ *      Event event : The RenderWindow event
+ * Returns: True if the space bar was released, false otherwise
+ */
+bool SFMLhelper::SpacebarReleased(Event event)
+{
+    return (event.type == Event::KeyReleased) 
+            and (event.key.code == Keyboard::Space);
+}
+
+/*
+ * waitEvent
+ * Purpose: Wait for the next window event, but no longer than the timeout
+ * Parameters:
+ *      RenderWindow &window : The window
+ *              Event &event : Set to the event if there was one
+ *              Time timeout : The longest time to wait
+ * Returns: True if there was an event, false if the timeout passed first
+ * note: SFML's waitEvent can't time out, so the window is checked every
+ *       EVENT_WAIT_SLICE milliseconds, sleeping in between
+ */
+bool SFMLhelper::waitEvent(RenderWindow &window, Event &event, Time timeout)
+{
+    Clock clock;
+    while (not window.pollEvent(event)) {
+        Time left = timeout - clock.getElapsedTime();
+        if (left <= Time::Zero) {
+            return false;
+        }
+        sleep(min(left, milliseconds(EVENT_WAIT_SLICE)));
+    }
+    return true;
+}
+
+/*
+ * needsRedraw
+ * Purpose: Determines whether the window has to be drawn again because of
+ *          the event (its contents may have been lost)
+ * Parameters:
+ *      Event event : The RenderWindow event
+ * Returns: True if the window was resized or regained focus, false otherwise
+ */
+bool SFMLhelper::needsRedraw(Event event)
+{
+    return (event.type == Event::Resized) or (event.type == Event::GainedFocus);
+}
+
 
 /******************************************************\
  *                    Time Funcs                       *
@@ -0,0 +1,260 @@
+/*
+ * Project: minesweeper
+ * Name: SnapshotBuffer.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the SnapshotBuffer class (a triple buffer). The
+ *          writer publishes by swapping its snapshot with the shared one,
+ *          marked fresh, and the reader takes a fresh shared snapshot by
+ *          swapping it with its own. A snapshot the reader never took is
+ *          replaced by the next one, so each snapshot lists every cell that
+ *          changed since the last one the reader is known to have taken (a
+ *          cell may be listed again, its state is always read from the
+ *          snapshot's cells). The changes are also kept until every
+ *          snapshot's cells have them, so capturing only copies the cells
+ *          changed since that snapshot was last written.
+ */
+
+#include "../Files_h/SnapshotBuffer.h"
+#include "../Files_h/Board.h"
+#include "SFML/Graphics.hpp"
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <algorithm>
+
+/* flag on the shared index when it holds a snapshot the reader hasn't taken */
+static const int FRESH      = 4;
+static const int INDEX_MASK = 3;
+
+/* a snapshot whose cells must be copied whole on its next capture */
+static const size_t STALE_SLOT = (size_t)-1;
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * SnapshotBuffer
+ * purpose: Initialize a buffer with nothing published
+ * parameters: n/a
+ * returns: n/a
+ */
+SnapshotBuffer::SnapshotBuffer()
+{
+    for (int i = 0; i < 3; ++i) {
+        slots[i].rows = slots[i].cols = 0;
+        slots[i].sequence = 0;
+        slots[i].flagsLeft = 0;
+        current[i] = STALE_SLOT;
+    }
+    writing = 0;
+    reading = 1;
+    shared = 2;
+    lastPublished = 0;
+    published = 0;
+    historyStart = 0;
+    woken = false;
+}
+
+
+/******************************************************\
+ *                   Writer Side                       *
+\******************************************************/
+
+/*
+ * back
+ * purpose: Returns the snapshot being written
+ * parameters: n/a
+ * returns: The writer's snapshot (only the writer may use it)
+ */
+BoardSnapshot &SnapshotBuffer::back()
+{
+    return slots[writing];
+}
+
+/*
+ * capture
+ * purpose: Copy the board into the snapshot being written, along with the
+ *          cells that changed since the reader last took a snapshot
+ * parameters:
+ *      Board &board : The board (its change log is emptied)
+ * returns: n/a
+ * note: The time and view are left for the caller to set. Only the cells
+ *       changed since this snapshot was last written are copied (all of them
+ *       the first time, after restart, or if it fell a board's worth of
+ *       changes behind).
+ */
+void SnapshotBuffer::capture(Board &board)
+{
+    BoardSnapshot &snapshot = slots[writing];
+    int rows = board.getNumRows(), cols = board.getNumCols();
+    board.takeChanges(snapshot.changed);
+    history.insert(history.end(), snapshot.changed.begin(), snapshot.changed.end());
+    size_t end = historyStart + history.size();
+
+    /* bring the snapshot's cells up to date */
+    if ((current[writing] == STALE_SLOT) or (snapshot.rows != rows) or (snapshot.cols != cols)) {
+        board.getDrawn(snapshot.cells);
+    } else {
+        for (size_t i = current[writing]; i < end; ++i) {
+            Pos cell = history[i - historyStart];
+            snapshot.cells[(cell.first * cols) + cell.second] = board.getDrawnCell(cell.first, cell.second);
+        }
+    }
+    current[writing] = end;
+    trimHistory(rows * cols);
+
+    snapshot.rows = rows;
+    snapshot.cols = cols;
+    snapshot.flagsLeft = board.numFlags();
+    unseen.insert(unseen.end(), snapshot.changed.begin(), snapshot.changed.end());
+    snapshot.changed = unseen;
+}
+
+/*
+ * publish
+ * purpose: Hand the snapshot being written to the reader and start writing
+ *          into another one
+ * parameters: n/a
+ * returns: n/a
+ * note: Never waits. A published snapshot the reader hasn't taken yet is
+ *       replaced.
+ */
+void SnapshotBuffer::publish()
+{
+    slots[writing].sequence = ++published;
+    slots[writing].published.restart();
+    int previous = shared.exchange(writing | FRESH, memory_order_acq_rel);
+    writing = previous & INDEX_MASK;
+
+    /* if the reader took the last snapshot it has seen those changes */
+    if (not (previous & FRESH)) {
+        unseen.erase(unseen.begin(), unseen.begin() + lastPublished);
+    }
+    lastPublished = unseen.size();
+
+    /* wake the reader if it is waiting (taking the lock first so the wake
+       can't fall between its check and its wait) */
+    {
+        lock_guard<mutex> guard(wakeLock);
+    }
+    wakeUp.notify_one();
+}
+
+/*
+ * restart
+ * purpose: Start over with another board, copying the next board captured
+ *          into each snapshot whole
+ * parameters: n/a
+ * returns: n/a
+ * expectations: The reader isn't running (its snapshot's cells are also
+ *               copied whole the next time it is written)
+ */
+void SnapshotBuffer::restart()
+{
+    history.clear();
+    historyStart = 0;
+    unseen.clear();
+    lastPublished = 0;
+    for (int i = 0; i < 3; ++i) {
+        current[i] = STALE_SLOT;
+    }
+}
+
+/*
+ * wake
+ * purpose: Wake the reader if it is waiting, without publishing
+ * parameters: n/a
+ * returns: n/a
+ * note: Used to stop the reader's thread
+ */
+void SnapshotBuffer::wake()
+{
+    {
+        lock_guard<mutex> guard(wakeLock);
+        woken = true;
+    }
+    wakeUp.notify_one();
+}
+
+
+/******************************************************\
+ *                   Reader Side                       *
+\******************************************************/
+
+/*
+ * take
+ * purpose: Take the latest published snapshot if there is a new one
+ * parameters: n/a
+ * returns: True if front now has a snapshot it didn't have before
+ * note: Never waits
+ */
+bool SnapshotBuffer::take()
+{
+    if (not (shared.load(memory_order_acquire) & FRESH)) {
+        return false;
+    }
+    reading = shared.exchange(reading, memory_order_acq_rel) & INDEX_MASK;
+    return true;
+}
+
+/*
+ * front
+ * purpose: Returns the snapshot last taken by the reader
+ * parameters: n/a
+ * returns: The reader's snapshot (only the reader may use it, and it doesn't
+ *          change until the next take)
+ */
+const BoardSnapshot &SnapshotBuffer::front()
+{
+    return slots[reading];
+}
+
+/*
+ * wait
+ * purpose: Sleep until a snapshot is published, wake is called or the time
+ *          runs out
+ * parameters:
+ *      Time timeout : The longest to sleep
+ * returns: True if a snapshot the reader hasn't taken is waiting
+ */
+bool SnapshotBuffer::wait(Time timeout)
+{
+    unique_lock<mutex> lock(wakeLock);
+    wakeUp.wait_for(lock, chrono::microseconds(max(Int64(0), timeout.asMicroseconds())), [this]() {
+        return woken or (shared.load(memory_order_acquire) & FRESH);
+    });
+    woken = false;
+    return shared.load(memory_order_acquire) & FRESH;
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * trimHistory
+ * purpose: Forget the changes every snapshot's cells already have
+ * parameters:
+ *      size_t limit : Most changes a snapshot may fall behind by (a snapshot
+ *                     further behind is copied whole on its next capture)
+ * returns: n/a
+ */
+void SnapshotBuffer::trimHistory(size_t limit)
+{
+    size_t end = historyStart + history.size();
+    size_t oldest = end;
+    for (int i = 0; i < 3; ++i) {
+        if ((current[i] != STALE_SLOT) and (end - current[i] > limit)) {
+            current[i] = STALE_SLOT;
+        } else if (current[i] != STALE_SLOT) {
+            oldest = min(oldest, current[i]);
+        }
+    }
+    history.erase(history.begin(), history.begin() + (oldest - historyStart));
+    historyStart = oldest;
+}
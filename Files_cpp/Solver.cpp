@@ -0,0 +1,691 @@
+/*
+ * Project: minesweeper
+ * Name: Solver.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the Solver class. Finds the safe cells and
+ *          mines that follow directly from the numbers on the board, then
+ *          counts every arrangement of mines that agrees with the remaining
+ *          numbers to get the exact probability of each hidden cell being a
+ *          mine.
+ */
+
+#include "../Files_h/Solver.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+
+/* for adjacent block iteration */
+static const int ADJACENT_BLOCKS = 8;
+static const int R[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+static const int C[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+
+/* what is known about each cell */
+static const int UNKNOWN  = 0;
+static const int SAFE     = 1;
+static const int MINED    = 2;
+static const int REVEALED = 3;
+
+/* invalid coordinates */
+static const Pos INVALID = make_pair(-1, -1);
+
+/* max search steps per group of cells before falling back to an estimate */
+static const long NODE_LIMIT = 1000000;
+
+/* search steps between checks of the cancel flag */
+static const long CANCEL_CHECK = 1024;
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * Solver
+ * purpose: Initialize an empty solver
+ * parameters: n/a
+ * returns: n/a
+ * note: solve must be called before any of the getters are used
+ */
+Solver::Solver()
+{
+    numRows = numCols = numMines = 0;
+    allExact = true;
+    nodes = 0;
+    cancel = NULL;
+}
+
+
+/******************************************************\
+ *                  Solve Functions                    *
+\******************************************************/
+
+/*
+ * solve
+ * purpose: Find the safe cells, mines and mine probabilities of the given
+ *          board
+ * parameters:
+ *      const vector<int> &cells : The visible board in row major order (see
+ *                                 Board::getVisible)
+ *                      int rows : Number of rows on the board
+ *                      int cols : Number of columns on the board
+ *                     int mines : Total number of mines on the board
+ * returns: n/a
+ * expectations: The size of cells is rows * cols. CRE if violated.
+ */
+void Solver::solve(const vector<int> &cells, int rows, int cols, int mines)
+{
+    /* find what follows directly from each number, then count the rest */
+    reset(cells, rows, cols, mines);
+    deduce();
+    buildComponents();
+    combine();
+}
+
+/*
+ * solveSimple
+ * purpose: Find only the safe cells and mines that follow directly from each
+ *          number, without counting arrangements
+ * parameters:
+ *      const vector<int> &cells : The visible board in row major order (see
+ *                                 Board::getVisible)
+ *                      int rows : Number of rows on the board
+ *                      int cols : Number of columns on the board
+ *                     int mines : Total number of mines on the board
+ * returns: n/a
+ * note: Much faster than solve but may miss safe cells and mines. The
+ *       probabilities are not computed (0 unless the cell is a mine) and 
+ *       exact returns false.
+ * expectations: The size of cells is rows * cols. CRE if violated.
+ */
+void Solver::solveSimple(const vector<int> &cells, int rows, int cols, int mines)
+{
+    reset(cells, rows, cols, mines);
+    deduce();
+    for (size_t i = 0; i < state.size(); ++i) {
+        probability[i] = (state[i] == MINED) ? 1 : 0;
+    }
+    allExact = false;
+}
+
+
+/******************************************************\
+ *                      Getters                        *
+\******************************************************/
+
+/*
+ * isSafe
+ * purpose: Returns whether the given hidden cell is certain to not be a mine
+ * parameters:
+ *      int row : The row of the desired cell
+ *      int col : The column of the desired cell
+ * returns: True if no arrangement of mines covers the cell, false otherwise
+ */
+bool Solver::isSafe(int row, int col)
+{
+    assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
+    return state[(row * numCols) + col] == SAFE;
+}
+
+/*
+ * isMine
+ * purpose: Returns whether the given cell is certain to be a mine
+ * parameters:
+ *      int row : The row of the desired cell
+ *      int col : The column of the desired cell
+ * returns: True if every arrangement of mines covers the cell, false otherwise
+ */
+bool Solver::isMine(int row, int col)
+{
+    assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
+    return state[(row * numCols) + col] == MINED;
+}
+
+/*
+ * mineProbability
+ * purpose: Returns the probability of the given cell being a mine
+ * parameters:
+ *      int row : The row of the desired cell
+ *      int col : The column of the desired cell
+ * returns: The probability between 0 and 1 (0 for revealed cells)
+ */
+double Solver::mineProbability(int row, int col)
+{
+    assert(row >= 0 and row < numRows and col >= 0 and col < numCols);
+    return probability[(row * numCols) + col];
+}
+
+/*
+ * safeCells
+ * purpose: Returns every hidden cell that is certain to not be a mine
+ * parameters: n/a
+ * returns: The safe cells in row major order
+ */
+vector<Pos> Solver::safeCells()
+{
+    vector<Pos> safe;
+    for (size_t i = 0; i < state.size(); ++i) {
+        if (state[i] == SAFE) {
+            safe.push_back(make_pair(i / numCols, i % numCols));
+        }
+    }
+    return safe;
+}
+
+/*
+ * bestGuess
+ * purpose: Returns the hidden cell least likely to be a mine
+ * parameters: n/a
+ * returns: The position of the cell, or (-1, -1) if every hidden cell is a
+ *          mine
+ */
+Pos Solver::bestGuess()
+{
+    Pos best = INVALID;
+    double bestProb = 2;
+    for (size_t i = 0; i < state.size(); ++i) {
+        bool candidate = (state[i] == UNKNOWN) or (state[i] == SAFE);
+        if (candidate and (probability[i] < bestProb)) {
+            bestProb = probability[i];
+            best = make_pair(i / numCols, i % numCols);
+        }
+    }
+    return best;
+}
+
+/*
+ * exact
+ * purpose: Returns whether every probability from the last solve is exact
+ * parameters: n/a
+ * returns: False if a group of cells was too large to count and had its
+ *          probabilities estimated, true otherwise
+ */
+bool Solver::exact()
+{
+    return allExact;
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * reset
+ * purpose: Save the board and clear the results of the last solve
+ * parameters:
+ *      const vector<int> &cells : The visible board in row major order
+ *                      int rows : Number of rows on the board
+ *                      int cols : Number of columns on the board
+ *                     int mines : Total number of mines on the board
+ * returns: n/a
+ * expectations: The size of cells is rows * cols. CRE if violated.
+ */
+void Solver::reset(const vector<int> &cells, int rows, int cols, int mines)
+{
+    assert((int)cells.size() == rows * cols);
+
+    /* save the board */
+    board = cells;
+    numRows = rows;
+    numCols = cols;
+    numMines = mines;
+    allExact = true;
+
+    /* mark the revealed cells */
+    state.assign(cells.size(), UNKNOWN);
+    probability.assign(cells.size(), 0);
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (cells[i] == MINE) {
+            state[i] = MINED;
+        } else if (cells[i] != HIDDEN) {
+            state[i] = REVEALED;
+        }
+    }
+}
+
+/*
+ * deduce
+ * purpose: Repeatedly mark the hidden cells around a number as safe when the
+ *          number's mines are all found, or as mines when there are exactly
+ *          as many hidden cells as missing mines
+ * parameters: n/a
+ * returns: n/a
+ */
+void Solver::deduce()
+{
+    /* start with every revealed number */
+    vector<int> queue;
+    for (size_t i = 0; i < board.size(); ++i) {
+        if (state[i] == REVEALED) {
+            queue.push_back(i);
+        }
+    }
+
+    /* recheck the numbers around every cell that becomes certain */
+    int adjacent[ADJACENT_BLOCKS];
+    while (not queue.empty()) {
+        int cell = queue.back();
+        queue.pop_back();
+
+        /* count the unknown cells and the mines around the number */
+        int count = neighbors(cell, adjacent);
+        int unknown = 0, mines = 0;
+        for (int i = 0; i < count; ++i) {
+            unknown += (state[adjacent[i]] == UNKNOWN);
+            mines   += (state[adjacent[i]] == MINED);
+        }
+        if (unknown == 0) {
+            continue;
+        }
+
+        /* mark the unknown cells if the number decides all of them */
+        int missing = board[cell] - mines;
+        if ((missing != 0) and (missing != unknown)) {
+            continue;
+        }
+        int value = (missing == 0) ? SAFE : MINED;
+        for (int i = 0; i < count; ++i) {
+            if (state[adjacent[i]] == UNKNOWN) {
+                setCertain(adjacent[i], value, queue);
+            }
+        }
+    }
+}
+
+/*
+ * buildComponents
+ * purpose: Turn each number next to an unknown cell into a constraint and
+ *          group the unknown cells that share constraints
+ * parameters: n/a
+ * returns: n/a
+ */
+void Solver::buildComponents()
+{
+    constraints.clear();
+    components.clear();
+    cellConstraints.assign(board.size(), vector<int>());
+
+    /* make a constraint for each number touching an unknown cell */
+    int adjacent[ADJACENT_BLOCKS];
+    for (size_t cell = 0; cell < board.size(); ++cell) {
+        if (state[cell] != REVEALED) {
+            continue;
+        }
+        Constraint constraint;
+        constraint.mines = board[cell];
+        int count = neighbors(cell, adjacent);
+        for (int i = 0; i < count; ++i) {
+            if (state[adjacent[i]] == MINED) {
+                --constraint.mines;
+            } else if (state[adjacent[i]] == UNKNOWN) {
+                constraint.vars.push_back(adjacent[i]);
+            }
+        }
+        if (constraint.vars.empty()) {
+            continue;
+        }
+        for (size_t i = 0; i < constraint.vars.size(); ++i) {
+            cellConstraints[constraint.vars[i]].push_back(constraints.size());
+        }
+        constraints.push_back(constraint);
+    }
+
+    /* group the cells with a breadth first search over the constraints */
+    vector<bool> seenVar(board.size(), false);
+    vector<bool> seenConstraint(constraints.size(), false);
+    for (size_t start = 0; start < constraints.size(); ++start) {
+        if (seenConstraint[start]) {
+            continue;
+        }
+        Component comp;
+        comp.constraints.push_back(start);
+        seenConstraint[start] = true;
+        for (size_t c = 0; c < comp.constraints.size(); ++c) {
+            vector<int> &vars = constraints[comp.constraints[c]].vars;
+            for (size_t v = 0; v < vars.size(); ++v) {
+                if (seenVar[vars[v]]) {
+                    continue;
+                }
+                seenVar[vars[v]] = true;
+                comp.vars.push_back(vars[v]);
+                vector<int> &linked = cellConstraints[vars[v]];
+                for (size_t l = 0; l < linked.size(); ++l) {
+                    if (not seenConstraint[linked[l]]) {
+                        seenConstraint[linked[l]] = true;
+                        comp.constraints.push_back(linked[l]);
+                    }
+                }
+            }
+        }
+        components.push_back(comp);
+    }
+
+    /* size the search state (the search leaves every cell unassigned) */
+    assignment.assign(board.size(), -1);
+    placed.assign(constraints.size(), 0);
+    unassigned.assign(constraints.size(), 0);
+}
+
+/*
+ * setCancel
+ * purpose: Give the solver a flag that stops a solve in progress when set
+ *          from another thread
+ * parameters:
+ *      const atomic<bool> *flag : The flag (NULL to never stop)
+ * returns: n/a
+ * note: A cancelled solve returns soon after the flag is set, with its
+ *       results estimated (exact returns false). The flag must outlive the
+ *       solver or be replaced first.
+ */
+void Solver::setCancel(const atomic<bool> *flag)
+{
+    cancel = flag;
+}
+
+/*
+ * enumerate
+ * purpose: Count every arrangement of mines in the group that satisfies its
+ *          constraints, by number of mines used
+ * parameters:
+ *      Component &comp : The group of cells
+ * returns: True if the count finished, false if it went over NODE_LIMIT or
+ *          was cancelled
+ */
+bool Solver::enumerate(Component &comp)
+{
+    /* reset the counts */
+    comp.solutions.assign(comp.vars.size() + 1, 0);
+    comp.mineCounts.assign(comp.vars.size() + 1, vector<double>(comp.vars.size(), 0));
+
+    /* reset the search state of the group's constraints */
+    for (size_t i = 0; i < comp.constraints.size(); ++i) {
+        placed[comp.constraints[i]] = 0;
+        unassigned[comp.constraints[i]] = constraints[comp.constraints[i]].vars.size();
+    }
+
+    nodes = 0;
+    search(comp, 0, 0);
+    return nodes <= NODE_LIMIT;
+}
+
+/*
+ * search
+ * purpose: Try both values for the next cell in the group and record every
+ *          complete arrangement that satisfies the constraints
+ * parameters:
+ *      Component &comp : The group of cells
+ *         size_t index : Index of the next cell in the group to assign
+ *            int mines : Number of mines placed so far
+ * returns: n/a
+ */
+void Solver::search(Component &comp, size_t index, int mines)
+{
+    /* give up once the search gets too large or is cancelled */
+    if (++nodes > NODE_LIMIT) {
+        return;
+    }
+    if ((cancel != NULL) and (nodes % CANCEL_CHECK == 0) and (cancel->load(memory_order_relaxed))) {
+        nodes = NODE_LIMIT + 1;
+        return;
+    }
+
+    /* record a complete arrangement */
+    if (index == comp.vars.size()) {
+        comp.solutions[mines] += 1;
+        for (size_t i = 0; i < comp.vars.size(); ++i) {
+            comp.mineCounts[mines][i] += assignment[comp.vars[i]];
+        }
+        return;
+    }
+
+    /* try the cell as safe, then as a mine */
+    int var = comp.vars[index];
+    vector<int> &linked = cellConstraints[var];
+    for (int value = 0; value <= 1; ++value) {
+        assignment[var] = value;
+        for (size_t i = 0; i < linked.size(); ++i) {
+            placed[linked[i]] += value;
+            --unassigned[linked[i]];
+        }
+        if (consistent(var)) {
+            search(comp, index + 1, mines + value);
+        }
+        for (size_t i = 0; i < linked.size(); ++i) {
+            placed[linked[i]] -= value;
+            ++unassigned[linked[i]];
+        }
+    }
+    assignment[var] = -1;
+}
+
+/*
+ * consistent
+ * purpose: Check the constraints touching a newly assigned cell
+ * parameters:
+ *      int var : The cell that was assigned
+ * returns: True if every constraint can still be satisfied, false otherwise
+ */
+bool Solver::consistent(int var)
+{
+    vector<int> &linked = cellConstraints[var];
+    for (size_t i = 0; i < linked.size(); ++i) {
+        int need = constraints[linked[i]].mines;
+        if ((placed[linked[i]] > need) or (placed[linked[i]] + unassigned[linked[i]] < need)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * combine
+ * purpose: Weight each group's arrangements by the number of ways to place
+ *          the leftover mines in the unconstrained cells and turn the counts
+ *          into probabilities
+ * parameters: n/a
+ * returns: n/a
+ * note: If a group had to be estimated, no counted cell is marked certain
+ *       (it keeps its probability)
+ */
+void Solver::combine()
+{
+    /* count the mines left to place */
+    int mines = numMines;
+    for (size_t i = 0; i < state.size(); ++i) {
+        mines -= (state[i] == MINED);
+        probability[i] = (state[i] == MINED) ? 1 : 0;
+    }
+
+    /* count each group, estimating the ones that are too large */
+    vector<bool> inGroup(board.size(), false);
+    vector<Component *> counted;
+    for (size_t c = 0; c < components.size(); ++c) {
+        Component &comp = components[c];
+        for (size_t i = 0; i < comp.vars.size(); ++i) {
+            inGroup[comp.vars[i]] = true;
+        }
+        if (enumerate(comp)) {
+            counted.push_back(&comp);
+            continue;
+        }
+
+        /* estimate with the tightest constraint on each cell */
+        allExact = false;
+        double expected = 0;
+        for (size_t i = 0; i < comp.vars.size(); ++i) {
+            vector<int> &linked = cellConstraints[comp.vars[i]];
+            double estimate = 0;
+            for (size_t l = 0; l < linked.size(); ++l) {
+                Constraint &constraint = constraints[linked[l]];
+                estimate = max(estimate, (double)constraint.mines / constraint.vars.size());
+            }
+            probability[comp.vars[i]] = estimate;
+            expected += estimate;
+        }
+        mines = max(0, mines - (int)lround(expected));
+    }
+
+    /* cells that touch no number */
+    int others = 0;
+    for (size_t i = 0; i < state.size(); ++i) {
+        others += (state[i] == UNKNOWN) and (not inGroup[i]);
+    }
+
+    /* distribution of the total mines in the counted groups */
+    vector<double> total(1, 1);
+    for (size_t c = 0; c < counted.size(); ++c) {
+        vector<double> &solutions = counted[c]->solutions;
+        vector<double> next(total.size() + solutions.size() - 1, 0);
+        for (size_t a = 0; a < total.size(); ++a) {
+            for (size_t b = 0; b < solutions.size(); ++b) {
+                next[a + b] += total[a] * solutions[b];
+            }
+        }
+        total = next;
+    }
+
+    /* ways to place the leftover mines in the other cells (scaled) */
+    vector<double> logWays(total.size(), -INFINITY);
+    double maxLog = -INFINITY;
+    for (size_t k = 0; k < total.size(); ++k) {
+        int left = mines - k;
+        if ((left >= 0) and (left <= others)) {
+            logWays[k] = lgamma(others + 1) - lgamma(left + 1) - lgamma(others - left + 1);
+            maxLog = max(maxLog, logWays[k]);
+        }
+    }
+    vector<double> ways(total.size(), 0);
+    for (size_t k = 0; k < total.size(); ++k) {
+        ways[k] = (logWays[k] == -INFINITY) ? 0 : exp(logWays[k] - maxLog);
+    }
+
+    /* probability of each unconstrained cell */
+    double weight = 0, otherMines = 0;
+    for (size_t k = 0; k < total.size(); ++k) {
+        weight += total[k] * ways[k];
+        if (others > 0) {
+            otherMines += total[k] * ways[k] * (mines - (int)k) / others;
+        }
+    }
+
+    /* numbers contradict each other or the mine count, so guess uniformly */
+    if (weight <= 0) {
+        allExact = false;
+        int unknown = 0;
+        for (size_t i = 0; i < state.size(); ++i) {
+            unknown += (state[i] == UNKNOWN);
+        }
+        for (size_t i = 0; i < state.size(); ++i) {
+            if (state[i] == UNKNOWN) {
+                probability[i] = (double)max(0, mines) / max(1, unknown);
+            }
+        }
+        return;
+    }
+    /* (a cell is only certain if every group was counted, since an
+       estimated group leaves the mines left over a guess) */
+    for (size_t i = 0; i < state.size(); ++i) {
+        if ((state[i] == UNKNOWN) and (not inGroup[i])) {
+            probability[i] = otherMines / weight;
+            if ((allExact) and (otherMines == 0)) {
+                state[i] = SAFE;
+            } else if ((allExact) and (otherMines == weight)) {
+                state[i] = MINED;
+            }
+        }
+    }
+
+    /* probability of each cell in the counted groups */
+    for (size_t c = 0; c < counted.size(); ++c) {
+
+        /* distribution of the mines in every other group */
+        vector<double> rest(1, 1);
+        for (size_t o = 0; o < counted.size(); ++o) {
+            if (o == c) {
+                continue;
+            }
+            vector<double> &solutions = counted[o]->solutions;
+            vector<double> next(rest.size() + solutions.size() - 1, 0);
+            for (size_t a = 0; a < rest.size(); ++a) {
+                for (size_t b = 0; b < solutions.size(); ++b) {
+                    next[a + b] += rest[a] * solutions[b];
+                }
+            }
+            rest = next;
+        }
+
+        /* weight of each mine count in this group */
+        Component &comp = *counted[c];
+        vector<double> groupWeight(comp.solutions.size(), 0);
+        double groupTotal = 0;
+        for (size_t k = 0; k < comp.solutions.size(); ++k) {
+            for (size_t r = 0; r < rest.size() and k + r < ways.size(); ++r) {
+                groupWeight[k] += rest[r] * ways[k + r];
+            }
+            groupTotal += comp.solutions[k] * groupWeight[k];
+        }
+
+        /* probability of each cell */
+        for (size_t i = 0; i < comp.vars.size(); ++i) {
+            double cellWeight = 0;
+            for (size_t k = 0; k < comp.solutions.size(); ++k) {
+                cellWeight += comp.mineCounts[k][i] * groupWeight[k];
+            }
+            int var = comp.vars[i];
+            probability[var] = cellWeight / groupTotal;
+            if ((allExact) and (cellWeight == 0)) {
+                state[var] = SAFE;
+            } else if ((allExact) and (cellWeight == groupTotal)) {
+                state[var] = MINED;
+            }
+        }
+    }
+}
+
+/*
+ * setCertain
+ * purpose: Mark a cell as certainly safe or a mine and queue the numbers
+ *          around it to be checked again
+ * parameters:
+ *                int cell : Index of the cell
+ *               int value : SAFE or MINED
+ *      vector<int> &queue : Numbers waiting to be checked
+ * returns: n/a
+ */
+void Solver::setCertain(int cell, int value, vector<int> &queue)
+{
+    state[cell] = value;
+    int adjacent[ADJACENT_BLOCKS];
+    int count = neighbors(cell, adjacent);
+    for (int i = 0; i < count; ++i) {
+        if (state[adjacent[i]] == REVEALED) {
+            queue.push_back(adjacent[i]);
+        }
+    }
+}
+
+/*
+ * neighbors
+ * purpose: Find the in bounds cells adjacent to the given cell
+ * parameters:
+ *           int cell : Index of the cell
+ *      int *adjacent : Array of at least 8 ints to fill with the neighbors
+ * returns: The number of neighbors found
+ */
+int Solver::neighbors(int cell, int *adjacent)
+{
+    int row = cell / numCols, col = cell % numCols;
+    int count = 0;
+    for (int i = 0; i < ADJACENT_BLOCKS; ++i) {
+        int adjRow = row + R[i], adjCol = col + C[i];
+        bool rowInRange = (adjRow >= 0) and (adjRow < numRows);
+        bool colInRange = (adjCol >= 0) and (adjCol < numCols);
+        if (rowInRange and colInRange) {
+            adjacent[count++] = (adjRow * numCols) + adjCol;
+        }
+    }
+    return count;
+}
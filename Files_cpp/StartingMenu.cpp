@@ -64,23 +64,26 @@ int StartingMenu::getDifficulty()
     /* draw menu */
     draw(window);
     
-    /* display screen until difficulty is chosen or window is exited */
-    while (window.isOpen()) {
-
-        Event event;
-        while (window.pollEvent(event)) {
-
-            /* check if user exited the window */
-            if (event.type == Event::Closed) {
-                window.close();     
-                return NO_DIFFICULTY_CHOSEN;           
-            }
-
-            /* return difficulty if it was pressed */
-            if ((SFML.leftClick(event)) and (difficultyChosen(window))) {
-                playButton();
-                return difficulty;                    
-            }
+    /* display screen until difficulty is chosen or window is exited (the
+       menu never changes, so sleep until there is an event) */
+    Event event;
+    while ((window.isOpen()) and (window.waitEvent(event))) {
+
+        /* check if user exited the window */
+        if (event.type == Event::Closed) {
+            window.close();     
+            return NO_DIFFICULTY_CHOSEN;           
+        }
+
+        /* return difficulty if it was pressed */
+        if ((SFML.leftClick(event)) and (difficultyChosen(window))) {
+            playButton();
+            return difficulty;                    
+        }
+
+        /* draw the menu again if its contents were lost */
+        if (SFML.needsRedraw(event)) {
+            draw(window);
         }
     }
     return NO_DIFFICULTY_CHOSEN;
@@ -0,0 +1,258 @@
+/*
+ * Project: minesweeper
+ * Name: TerminalRenderer.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the TerminalRenderer class. The status line is
+ *          at the top of the screen, the board below it (two columns per
+ *          cell) and the message line below the board. A frame is built in a
+ *          string, skipping the cursor moves and color changes the terminal
+ *          doesn't need, then written to stdout in one go.
+ */
+
+#include "../Files_h/TerminalRenderer.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Game_Constants.h"
+#include <vector>
+#include <string>
+#include <cerrno>
+#include <unistd.h>
+
+/* where the lines and the board are on the screen (lines and columns start
+   at 1) */
+static const int STATUS_LINE = 1;
+static const int BOARD_TOP   = 3;
+static const int BOARD_LEFT  = 2;
+
+/* the look of the cells (SGR codes, each resetting the last) */
+static const string PLAIN           = "0";
+static const string NUMBER_COLORS[] = {"0;1;34", "0;1;32", "0;1;31", "0;1;35",
+                                       "0;1;36", "0;1;33", "0;1", "0;1"};
+static const string FLAG_COLOR      = "0;1;31";
+static const string MINE_COLOR      = "0;1;41";
+static const char HIDDEN_CHAR = '.';
+static const char OPEN_CHAR   = ' ';
+static const char FLAG_CHAR   = 'F';
+static const char MINE_CHAR   = '*';
+
+
+/******************************************************\
+ *                    Constructor                      *
+\******************************************************/
+
+/*
+ * TerminalRenderer
+ * purpose: Initialize a renderer with no board
+ * parameters: n/a
+ * returns: n/a
+ */
+TerminalRenderer::TerminalRenderer()
+{
+    numRows = numCols = 0;
+    cursorLine = cursorColumn = 0;
+    color = PLAIN;
+    stale = true;
+}
+
+
+/******************************************************\
+ *                    Initializers                     *
+\******************************************************/
+
+/*
+ * setBoard
+ * purpose: Set the size of the board being drawn
+ * parameters:
+ *      int rows : Number of rows of cells
+ *      int cols : Number of columns of cells
+ * returns: n/a
+ */
+void TerminalRenderer::setBoard(int rows, int cols)
+{
+    numRows = rows;
+    numCols = cols;
+    drawn.assign(rows * cols, HIDDEN);
+    invalidate();
+}
+
+/*
+ * invalidate
+ * purpose: Clear the screen and draw everything on the next frame
+ * parameters: n/a
+ * returns: n/a
+ */
+void TerminalRenderer::invalidate()
+{
+    stale = true;
+}
+
+
+/******************************************************\
+ *                   Draw Function                     *
+\******************************************************/
+
+/*
+ * draw
+ * purpose: Bring the screen up to date with the board and the text
+ * parameters:
+ *              Board &board : The board (its change log is emptied)
+ *                Pos cursor : The cell the user is on (row:col)
+ *       const string &status : The line above the board
+ *      const string &message : The line below the board
+ * returns: True if the frame was written (or there was nothing to write),
+ *          false if stdout couldn't be written to
+ * note: Nothing is written when nothing changed. The lines are expected to
+ *       be ASCII and fit on one line of the terminal.
+ */
+bool TerminalRenderer::draw(Board &board, Pos cursor, const string &status, const string &message)
+{
+    board.getDrawn(cells);
+    board.takeChanges(changed);
+
+    if (stale) {
+        /* the whole screen, after clearing it (where the cursor is and the
+           colors are is no longer known) */
+        frame += "\x1b[0m\x1b[2J";
+        color = PLAIN;
+        cursorLine = cursorColumn = 0;
+        for (int row = 0; row < numRows; ++row) {
+            for (int col = 0; col < numCols; ++col) {
+                writeCell(row, col);
+            }
+        }
+    } else {
+        /* only the cells that look different (a cell may be listed twice) */
+        for (size_t i = 0; i < changed.size(); ++i) {
+            int row = changed[i].first, col = changed[i].second;
+            if (cells[(row * numCols) + col] != drawn[(row * numCols) + col]) {
+                writeCell(row, col);
+            }
+        }
+    }
+    writeLine(STATUS_LINE, status, drawnStatus);
+    writeLine(BOARD_TOP + numRows + 1, message, drawnMessage);
+    stale = false;
+
+    /* leave the terminal's cursor on the user's cell */
+    moveTo(BOARD_TOP + cursor.first, BOARD_LEFT + (2 * cursor.second));
+    return flush();
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * writeCell
+ * purpose: Add a cell, as the board is now, to the frame
+ * parameters:
+ *      int row : The row of the cell
+ *      int col : The column of the cell
+ * returns: n/a
+ */
+void TerminalRenderer::writeCell(int row, int col)
+{
+    int state = cells[(row * numCols) + col];
+    moveTo(BOARD_TOP + row, BOARD_LEFT + (2 * col));
+    if (state == HIDDEN) {
+        setColor(PLAIN);
+        frame += HIDDEN_CHAR;
+    } else if (state == FLAGGED) {
+        setColor(FLAG_COLOR);
+        frame += FLAG_CHAR;
+    } else if (state == MINE) {
+        setColor(MINE_COLOR);
+        frame += MINE_CHAR;
+    } else if (state == 0) {
+        setColor(PLAIN);
+        frame += OPEN_CHAR;
+    } else {
+        setColor(NUMBER_COLORS[state - 1]);
+        frame += (char)('0' + state);
+    }
+
+    /* the space after it, so the next cell of the row needs no move */
+    setColor(PLAIN);
+    frame += ' ';
+    cursorColumn += 2;
+    drawn[(row * numCols) + col] = state;
+}
+
+/*
+ * writeLine
+ * purpose: Add a line of text to the frame if it changed
+ * parameters:
+ *                int line : The line of the screen
+ *      const string &text : The text
+ *            string &last : The text last drawn on the line (set to text)
+ * returns: n/a
+ */
+void TerminalRenderer::writeLine(int line, const string &text, string &last)
+{
+    if ((not stale) and (text == last)) {
+        return;
+    }
+    moveTo(line, 1);
+    setColor(PLAIN);
+    frame += text;
+    frame += "\x1b[K";
+    cursorColumn += text.size();
+    last = text;
+}
+
+/*
+ * moveTo
+ * purpose: Add a cursor move to the frame, unless the cursor will already be
+ *          there
+ * parameters:
+ *        int line : The line (from 1)
+ *      int column : The column (from 1)
+ * returns: n/a
+ */
+void TerminalRenderer::moveTo(int line, int column)
+{
+    if ((line == cursorLine) and (column == cursorColumn)) {
+        return;
+    }
+    frame += "\x1b[" + to_string(line) + ";" + to_string(column) + "H";
+    cursorLine = line;
+    cursorColumn = column;
+}
+
+/*
+ * setColor
+ * purpose: Add a color change to the frame, unless the color is already on
+ * parameters:
+ *      const string &code : The SGR code of the color
+ * returns: n/a
+ */
+void TerminalRenderer::setColor(const string &code)
+{
+    if (code == color) {
+        return;
+    }
+    frame += "\x1b[" + code + "m";
+    color = code;
+}
+
+/*
+ * flush
+ * purpose: Write the frame to stdout and start a new one
+ * parameters: n/a
+ * returns: True if the frame was written, false otherwise
+ * note: The frame is one write unless the terminal takes only part of it
+ */
+bool TerminalRenderer::flush()
+{
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t count = write(STDOUT_FILENO, frame.data() + written, frame.size() - written);
+        if ((count < 0) and (errno != EINTR)) {
+            frame.clear();
+            return false;
+        }
+        written += (count > 0) ? count : 0;
+    }
+    frame.clear();
+    return true;
+}
@@ -0,0 +1,227 @@
+/*
+ * Project: minesweeper
+ * Name: TextureAtlas.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the TextureAtlas class. Images are packed onto
+ *          shelves (rows), tallest first, with a pixel of space around each
+ *          so neighbors never bleed into each other.
+ */
+
+#include "../Files_h/TextureAtlas.h"
+#include "SFML/Graphics.hpp"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+/* space between packed images */
+static const unsigned PADDING = 1;
+
+/* size of the block added by addColor (its middle texel is sampled) */
+static const unsigned COLOR_SIZE = 3;
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * TextureAtlas
+ * purpose: Initialize an empty atlas
+ * parameters: n/a
+ * returns: n/a
+ */
+TextureAtlas::TextureAtlas()
+{
+}
+
+
+/******************************************************\
+ *                   Add Functions                     *
+\******************************************************/
+
+/*
+ * add
+ * purpose: Add an image to be packed
+ * parameters:
+ *      const Image &image : The image
+ * returns: The image's id
+ * note: build must be called before the image can be drawn
+ */
+int TextureAtlas::add(const Image &image)
+{
+    images.push_back(image);
+    colorBlocks.push_back(false);
+    rects.push_back(FloatRect());
+    return images.size() - 1;
+}
+
+/*
+ * addScaled
+ * purpose: Add an image resized to the size it will be drawn at, so it is
+ *          drawn pixel for pixel
+ * parameters:
+ *      const Image &image : The image
+ *          unsigned width : Width to resize to
+ *         unsigned height : Height to resize to
+ * returns: The image's id
+ * note: Each new pixel is the average of the pixels of the image it covers
+ */
+int TextureAtlas::addScaled(const Image &image, unsigned width, unsigned height)
+{
+    Vector2u size = image.getSize();
+    width = max(1u, width);
+    height = max(1u, height);
+    Image scaled;
+    scaled.create(width, height, Color::Transparent);
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+
+            /* the pixels of the image under the new pixel */
+            unsigned left = (x * size.x) / width, right = max(left + 1, ((x + 1) * size.x) / width);
+            unsigned top = (y * size.y) / height, bottom = max(top + 1, ((y + 1) * size.y) / height);
+
+            /* average them, weighting the colors by how opaque they are */
+            double r = 0, g = 0, b = 0, a = 0;
+            for (unsigned sy = top; sy < bottom; ++sy) {
+                for (unsigned sx = left; sx < right; ++sx) {
+                    Color pixel = image.getPixel(sx, sy);
+                    r += pixel.r * pixel.a;
+                    g += pixel.g * pixel.a;
+                    b += pixel.b * pixel.a;
+                    a += pixel.a;
+                }
+            }
+            double count = (right - left) * (bottom - top);
+            if (a > 0) {
+                scaled.setPixel(x, y, Color(r / a, g / a, b / a, a / count));
+            }
+        }
+    }
+    return add(scaled);
+}
+
+/*
+ * addColor
+ * purpose: Add a block of one color, for drawing solid shapes from the atlas
+ * parameters:
+ *      Color color : The color (usually white, tinted by the vertex colors)
+ * returns: The block's id
+ * note: getRect returns the middle texel of the block, so sampling it never
+ *       touches a neighbor
+ */
+int TextureAtlas::addColor(Color color)
+{
+    Image block;
+    block.create(COLOR_SIZE, COLOR_SIZE, color);
+    int id = add(block);
+    colorBlocks[id] = true;
+    return id;
+}
+
+/*
+ * clear
+ * purpose: Remove every image
+ * parameters: n/a
+ * returns: n/a
+ */
+void TextureAtlas::clear()
+{
+    images.clear();
+    colorBlocks.clear();
+    rects.clear();
+}
+
+
+/******************************************************\
+ *                  Build Function                     *
+\******************************************************/
+
+/*
+ * build
+ * purpose: Pack every image into the texture
+ * parameters: n/a
+ * returns: True if the texture was made, false if it was too big
+ */
+bool TextureAtlas::build()
+{
+    /* make the atlas about square, but at least as wide as the widest image */
+    double area = 0;
+    unsigned widest = 1;
+    for (size_t i = 0; i < images.size(); ++i) {
+        Vector2u size = images[i].getSize();
+        area += (size.x + PADDING) * (size.y + PADDING);
+        widest = max(widest, size.x + (2 * PADDING));
+    }
+    unsigned width = max(widest, (unsigned)ceil(sqrt(area)) + PADDING);
+
+    /* place the images on shelves, tallest first */
+    vector<int> order(images.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [this](int a, int b) {
+        return images[a].getSize().y > images[b].getSize().y;
+    });
+    unsigned x = PADDING, y = PADDING, shelfHeight = 0;
+    vector<Vector2u> positions(images.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        Vector2u size = images[order[i]].getSize();
+        if (x + size.x + PADDING > width) {
+            x = PADDING;
+            y += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        positions[order[i]] = Vector2u(x, y);
+        x += size.x + PADDING;
+        shelfHeight = max(shelfHeight, size.y);
+    }
+    unsigned height = y + shelfHeight + PADDING;
+    if ((width > Texture::getMaximumSize()) or (height > Texture::getMaximumSize())) {
+        return false;
+    }
+
+    /* copy the images into one and upload it */
+    Image atlas;
+    atlas.create(width, height, Color::Transparent);
+    for (size_t i = 0; i < images.size(); ++i) {
+        Vector2u size = images[i].getSize();
+        atlas.copy(images[i], positions[i].x, positions[i].y);
+        rects[i] = FloatRect(positions[i].x, positions[i].y, size.x, size.y);
+        if (colorBlocks[i]) {
+            rects[i] = FloatRect(positions[i].x + 1.5f, positions[i].y + 1.5f, 0, 0);
+        }
+    }
+    return texture.loadFromImage(atlas);
+}
+
+
+/******************************************************\
+ *                      Getters                        *
+\******************************************************/
+
+/*
+ * getTexture
+ * purpose: Returns the packed texture
+ * parameters: n/a
+ * returns: The texture
+ */
+const Texture &TextureAtlas::getTexture() const
+{
+    return texture;
+}
+
+/*
+ * getRect
+ * purpose: Returns where an image was placed in the texture
+ * parameters:
+ *      int id : The image's id
+ * returns: The image's area of the texture in pixels (the middle texel for a
+ *          block added by addColor)
+ * expectations: The id is valid. CRE if violated.
+ */
+FloatRect TextureAtlas::getRect(int id) const
+{
+    assert(id >= 0 and id < (int)rects.size());
+    return rects[id];
+}
@@ -0,0 +1,144 @@
+/*
+ * Project: minesweeper
+ * Name: Timeline.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the Timeline class. The timeline's position
+ *          moves forward by the real time between updates times its speed,
+ *          and every action whose time has been reached runs, in order of
+ *          time (in the order they were added if at the same time).
+ */
+
+#include "../Files_h/Timeline.h"
+#include "SFML/System.hpp"
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+
+/******************************************************\
+ *                  Constructor                        *
+\******************************************************/
+
+/*
+ * Timeline
+ * purpose: Initialize an empty timeline at its start, playing in real time
+ * parameters: n/a
+ * returns: n/a
+ */
+Timeline::Timeline()
+{
+    next = 0;
+    position = Time::Zero;
+    playSpeed = 1;
+}
+
+
+/******************************************************\
+ *                   Scheduling                        *
+\******************************************************/
+
+/*
+ * at
+ * purpose: Schedule an action
+ * parameters:
+ *                           Time when : When the action runs, from the
+ *                                       start of the timeline
+ *      const function<void()> &action : The action
+ * returns: n/a
+ * note: An action scheduled before the current position runs on the next
+ *       update
+ */
+void Timeline::at(Time when, const function<void()> &action)
+{
+    Cue cue = {when, action};
+    size_t index = cues.size();
+    cues.push_back(cue);
+
+    /* keep the actions that haven't run sorted by time */
+    while ((index > next) and (cues[index - 1].when > when)) {
+        swap(cues[index - 1], cues[index]);
+        --index;
+    }
+}
+
+
+/******************************************************\
+ *                    Playback                         *
+\******************************************************/
+
+/*
+ * update
+ * purpose: Move the timeline forward by the time since the last update and
+ *          run the actions that are due
+ * parameters: n/a
+ * returns: n/a
+ */
+void Timeline::update()
+{
+    position += clock.restart() * playSpeed;
+    while ((next < cues.size()) and (cues[next].when <= position)) {
+        cues[next++].action();
+    }
+}
+
+/*
+ * setSpeed
+ * purpose: Set how many times faster than real time the timeline plays
+ * parameters:
+ *      float speed : The speed (1 for real time)
+ * returns: n/a
+ * note: The time before the change still counts at the old speed
+ */
+void Timeline::setSpeed(float speed)
+{
+    position += clock.restart() * playSpeed;
+    playSpeed = speed;
+}
+
+/*
+ * skip
+ * purpose: Jump to the end of the timeline, running every action that hasn't
+ *          run yet
+ * parameters: n/a
+ * returns: n/a
+ */
+void Timeline::skip()
+{
+    clock.restart();
+    while (next < cues.size()) {
+        position = cues[next].when;
+        cues[next++].action();
+    }
+}
+
+
+/******************************************************\
+ *                      Getters                        *
+\******************************************************/
+
+/*
+ * untilNext
+ * purpose: Returns how long (in real time) until the next action is due
+ * parameters: n/a
+ * returns: The time to wait before the next update, Time::Zero if an action
+ *          is already due or every action has run
+ */
+Time Timeline::untilNext()
+{
+    if (next == cues.size()) {
+        return Time::Zero;
+    }
+    Time left = cues[next].when - (position + (clock.getElapsedTime() * playSpeed));
+    return (left > Time::Zero) ? left / playSpeed : Time::Zero;
+}
+
+/*
+ * done
+ * purpose: Returns whether every action has run
+ * parameters: n/a
+ * returns: True if the timeline has played to its end
+ */
+bool Timeline::done()
+{
+    return next == cues.size();
+}
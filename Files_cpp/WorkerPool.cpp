@@ -0,0 +1,178 @@
+/*
+ * Project: minesweeper
+ * Name: WorkerPool.cpp
+ * Author: Tygan Chin
+ * Purpose: Implementation of the WorkerPool class. Tasks are queued in the
+ *          order they are submitted and each thread takes the next one as
+ *          soon as it is free. With no threads started, tasks run right away
+ *          on the thread that submits them.
+ */
+
+#include "../Files_h/WorkerPool.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+
+/******************************************************\
+ *             Constructor and Destructor              *
+\******************************************************/
+
+/*
+ * WorkerPool
+ * purpose: Initialize a pool with no threads
+ * parameters: n/a
+ * returns: n/a
+ * note: start must be called for tasks to run in the background
+ */
+WorkerPool::WorkerPool()
+{
+    running = 0;
+    stopped = false;
+}
+
+/*
+ * ~WorkerPool
+ * purpose: Finish the queued tasks and stop the threads
+ * parameters: n/a
+ * returns: n/a
+ */
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+
+/******************************************************\
+ *                   Run Functions                     *
+\******************************************************/
+
+/*
+ * start
+ * purpose: Start the threads that run the tasks
+ * parameters:
+ *      unsigned workers : Number of threads (one per core if 0)
+ * returns: n/a
+ * note: Does nothing if the pool was already started
+ */
+void WorkerPool::start(unsigned workers)
+{
+    if (not threads.empty()) {
+        return;
+    }
+    if (workers == 0) {
+        workers = max(1u, thread::hardware_concurrency());
+    }
+    stopped = false;
+    for (unsigned i = 0; i < workers; ++i) {
+        threads.push_back(thread(&WorkerPool::work, this));
+    }
+}
+
+/*
+ * stop
+ * purpose: Finish the queued tasks and wait for the threads to end
+ * parameters: n/a
+ * returns: n/a
+ */
+void WorkerPool::stop()
+{
+    {
+        lock_guard<mutex> guard(poolLock);
+        stopped = true;
+    }
+    taskAdded.notify_all();
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    threads.clear();
+}
+
+/*
+ * size
+ * purpose: Returns the number of threads
+ * parameters: n/a
+ * returns: The number of threads (0 if tasks run on the caller's thread)
+ */
+unsigned WorkerPool::size()
+{
+    return threads.size();
+}
+
+/*
+ * submit
+ * purpose: Queue a task to be run by the next free thread
+ * parameters:
+ *      const function<void()> &task : The task
+ * returns: n/a
+ * note: Runs the task before returning if no threads were started
+ */
+void WorkerPool::submit(const function<void()> &task)
+{
+    if (threads.empty()) {
+        task();
+        return;
+    }
+    {
+        lock_guard<mutex> guard(poolLock);
+        tasks.push_back(task);
+    }
+    taskAdded.notify_one();
+}
+
+/*
+ * wait
+ * purpose: Wait until every queued task has finished
+ * parameters: n/a
+ * returns: n/a
+ */
+void WorkerPool::wait()
+{
+    unique_lock<mutex> lock(poolLock);
+    while ((not tasks.empty()) or (running > 0)) {
+        tasksDone.wait(lock);
+    }
+}
+
+
+/******************************************************\
+ *                    Helper Funcs                     *
+\******************************************************/
+
+/*
+ * work
+ * purpose: Run queued tasks until the pool is stopped and the queue is empty
+ * parameters: n/a
+ * returns: n/a
+ * note: Runs on each of the pool's threads. The lock is released while a
+ *       task runs.
+ */
+void WorkerPool::work()
+{
+    unique_lock<mutex> lock(poolLock);
+    while (true) {
+        if (tasks.empty()) {
+            if (stopped) {
+                return;
+            }
+            taskAdded.wait(lock);
+            continue;
+        }
+
+        /* run the next task without holding the lock */
+        function<void()> task = tasks.front();
+        tasks.pop_front();
+        ++running;
+        lock.unlock();
+        task();
+        lock.lock();
+        --running;
+        if ((tasks.empty()) and (running == 0)) {
+            tasksDone.notify_all();
+        }
+    }
+}
@@ -14,14 +14,22 @@
 #include <set>
 #include <random>
 #include "Game_Constants.h"
-#include "SFML/Graphics.hpp"
 
 using namespace std;
-using namespace sf;
 
 /* the coordinate type for the board (row:col) */ 
 typedef pair<int, int> Pos;
 
+/* boards dealt ahead of time (see BoardPool.h) */
+class BoardPool;
+
+/* statistics of a generated board (see Generator.h) */
+struct generatorStats {
+    long boardsTried;
+    long boardsRejected;
+    double seconds;
+};
+
 class Board
 {
 public:
@@ -32,6 +40,16 @@ public:
     /* initializer (must be called in order for class to operate correctly) */
     void setBoard(int numRows, int numCols, int numBombs);
 
+    /* seed the random mine placement (for repeatable games) */
+    void setSeed(unsigned seed);
+
+    /* deal a board that can be solved without guessing on the first move */
+    void setNoGuess(bool noGuess);
+    void setPool(BoardPool *boardPool);
+
+    /* deal the board with a known set of mine locations (skips first move) */
+    void setLayout(const vector<Pos> &mines);
+
     /* game moves */
     int move(int row, int col);
     bool placeFlag(int row, int col);
@@ -43,9 +61,21 @@ public:
     int numFlags();
     int getNumRows();
     int getNumCols();
+    int getNumBombs();
     int getNumber(int row, int col);
     bool revealMine();
 
+    /* game record getters */
+    vector<Pos> getMoves();
+    vector<Pos> getMines();
+    void getVisible(vector<int> &cells);
+    void getDrawn(vector<int> &cells);
+    int getDrawnCell(int row, int col);
+    generatorStats getGeneratorStats();
+
+    /* cells revealed or flagged since the last call (for drawing) */
+    void takeChanges(vector<Pos> &cells);
+
 private:
 
     /* represents a single space on the board */
@@ -68,9 +98,20 @@ private:
     bool firstMove;
     mt19937 gen;
     Pos mineHit;
+    bool noGuess;
+    BoardPool *pool;
+    generatorStats genStats;
+
+    /* cells the user clicked on, in order */
+    vector<Pos> moves;
+
+    /* cells revealed, flagged or unflagged since takeChanges was last called */
+    vector<Pos> changes;
 
     /* helper functions */
+    int reveal(int row, int col);
     void openSpace(int &row, int &col);
+    bool showCell(int row, int col);
     void setBombs(int row, int col);
     void setNumbers(int &bombRow, int &bombCol);
 
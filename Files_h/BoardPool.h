@@ -0,0 +1,67 @@
+/*
+ * Project: minesweeper
+ * Name: BoardPool.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the BoardPool class. Keeps a ready no guessing board
+ *          for every first move of every difficulty, dealt ahead of time by a
+ *          background thread, so the first move never waits on the Generator.
+ */
+
+#ifndef BOARDPOOL_H
+#define BOARDPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Board.h"
+#include "Generator.h"
+#include "Game_Constants.h"
+
+using namespace std;
+
+class BoardPool
+{
+public:
+
+    /* constructor and destructor */
+    BoardPool();
+    ~BoardPool();
+
+    /* run functions */
+    void start();
+    void stop();
+    void setPriority(int difficulty);
+
+    /* take the ready board for the given first move (if there is one) */
+    bool take(int rows, int cols, int mines, Pos firstMove, vector<Pos> &layout);
+
+private:
+
+    /* a ready board for one first move (failed if none could be found) */
+    struct Slot {
+        bool ready;
+        bool failed;
+        vector<Pos> mines;
+    };
+
+    /* ready boards of each difficulty (row major by first move) */
+    vector<Slot> slots[NUM_DIFFS];
+    vector<int> fillOrder[NUM_DIFFS];
+
+    /* background thread and the state it shares with the game */
+    thread producer;
+    mutex poolLock;
+    condition_variable slotTaken;
+    bool stopped;
+    int priority;
+    unsigned seed;
+    Generator *current;
+
+    /* helper functions */
+    void produce();
+    bool nextSlot(int &difficulty, int &cell);
+    int findDifficulty(int rows, int cols, int mines);
+};
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * Project: minesweeper
+ * Name: BoardRenderer.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the BoardRenderer class. Draws the grid of a Board,
+ *          from snapshots of it (see SnapshotBuffer), over a cached
+ *          background of the lines and hidden cells with a vertex buffer per
+ *          64x64 tile of cells, textured by a TextureAtlas of the cell images
+ *          and numbers. Only the tiles in the target's view are drawn, and
+ *          only the tiles with a cell the snapshot lists as changed are built
+ *          again, on a pool of threads while the last ones are still drawn,
+ *          so neither the draw calls nor the work per frame grow with the
+ *          board. Zoomed out far enough that
+ *          cells are a few pixels wide, each 8x8 block of cells is drawn as
+ *          one quad colored by a running count of its cells' states. A big
+ *          opening is drawn over several frames, a frame's worth of time at
+ *          a time. On machines with shaders the grid can instead be drawn as
+ *          one quad, decoded per pixel from a texture of the cells' states.
+ */
+
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include "SFML/Graphics.hpp"
+#include "Board.h"
+#include "SnapshotBuffer.h"
+#include "TextureAtlas.h"
+#include "WorkerPool.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+using namespace std;
+using namespace sf;
+
+class BoardRenderer
+{
+public:
+
+    /* constructor */
+    BoardRenderer();
+
+    /* initializers (must be called before drawing) */
+    void setBoard(int rows, int cols, float cellSize, Vector2f origin, float lineThickness);
+    void setCellColors(Color hidden, Color shown, Color line);
+    void setDigits(const Text *digits);
+    void setImages(const string &flag, const string &won, const string &lost, float imageScale);
+    bool setShader(bool enabled);
+    void setWaiting(bool wait);
+
+    /* image and color of revealed mines (set by the end animation) */
+    void setMine(bool won, Color fill);
+
+    /* draw functions */
+    void update(const RenderTarget &target, const BoardSnapshot &boardShot);
+    bool revealing() const;
+    void draw(RenderTarget &target);
+
+private:
+
+    /* the board being drawn, the last snapshot whose changes were queued,
+       and where it is drawn */
+    const BoardSnapshot *snapshot;
+    unsigned long lastSequence;
+    int numRows;
+    int numCols;
+    float cellScaler;
+    float thickness;
+    float imageScale;
+    Vector2f topLeft;
+
+    /* looks of the cells */
+    Color hiddenColor;
+    Color shownColor;
+    Color lineColor;
+    Color mineColor;
+    bool mineWon;
+    const Font *digitFont;
+    unsigned digitSize;
+    Color digitColors[8];
+    Image images[3];
+    bool imageLoaded[3];
+
+    /* the images and numbers packed at the size they are drawn (at
+       atlasScale pixels a unit, which follows the zoom once it settles),
+       and the id of each in the atlas */
+    TextureAtlas atlas;
+    bool atlasStale;
+    float atlasScale;
+    int whiteId;
+    int imageIds[3];
+    int digitIds[8];
+    FloatRect digitBounds[8];
+
+    /* the quad of each number, the flag and the mine, centered in a cell at
+       the origin */
+    VertexArray iconQuads;
+
+    /* the lines and hidden cells, drawn once */
+    RenderTexture background;
+    Sprite backgroundSprite;
+    bool backgroundStale;
+
+    /* the cells in view (columns across, rows down) and how many pixels a
+       unit is drawn as */
+    IntRect shownCells;
+    float pixelScale;
+
+    /* what every cell was drawn as when last seen (row major), the cells
+       listed as changed but not yet applied, and whether every cell must be
+       checked again or every cell in view drawn again */
+    vector<int> states;
+    deque<Pos> pending;
+    bool statesStale;
+    bool shownStale;
+
+    /* the cell and its image or number for every cell in a tile (12
+       vertices per cell, row major), a spare buffer a worker builds the tile
+       into from a copy of its cells' states, whether it must be built again
+       and whether a worker is building it */
+    struct Tile {
+        vector<Vertex> vertices;
+        vector<Vertex> building;
+        vector<int> cells;
+        bool dirty;
+        bool inFlight;
+    };
+
+    /* every tile (row major, only the ones in view have vertices), the tiles
+       in view, how many are being built, whether some marked ones in view
+       were left for the next frame, the ones the workers finished but that
+       aren't swapped in yet, and whether update waits for them */
+    vector<Tile> tiles;
+    int tileCols;
+    IntRect shownTiles;
+    int tilesBuilding;
+    bool tilesLeft;
+    mutex finishedLock;
+    vector<int> finished;
+    bool waiting;
+
+    /* how many cells of each state are in a block of cells */
+    struct BlockSummary {
+        int hidden;
+        int flagged;
+        int shown;
+        int mines;
+    };
+
+    /* the summary of every block (row major), whether the blocks are drawn
+       instead of the cells, the blocks in view and one quad per block in
+       view */
+    vector<BlockSummary> blocks;
+    int blockCols;
+    bool lodShown;
+    IntRect shownBlocks;
+    VertexArray blockVertices;
+
+    /* the shader path: one texel per cell (number, state, flag), the cells
+       changed since the last upload, and the quad covering the grid */
+    bool useShader;
+    Shader shader;
+    Texture cellTexture;
+    vector<Uint8> texels;
+    vector<Uint8> uploadBuffer;
+    IntRect changed;
+    VertexArray boardQuad;
+
+    /* threads that build the tiles (last so they stop before the rest of
+       the renderer is destroyed) */
+    WorkerPool builders;
+
+    /* helper functions */
+    void buildAtlas();
+    void writeTexel(int row, int col, int state);
+    void uploadTexels();
+    void setUniforms();
+    int cellState(int row, int col);
+    void scanBoard();
+    void setState(int row, int col, int state);
+    void countState(BlockSummary &block, int state, int amount);
+    void writeCell(Vertex *cell, int row, int col, int state) const;
+    void writeBlock(int blockRow, int blockCol);
+    Color blockColor(const BlockSummary &block);
+    FloatRect cellArea(int row, int col) const;
+    int iconIndex(int state) const;
+    void cacheIcons();
+    void setQuad(Vertex *quad, FloatRect area, FloatRect texture, Color color) const;
+    void clearQuad(Vertex *quad) const;
+    void drawBackground();
+    FloatRect linesArea(IntRect cells);
+    IntRect visibleCells(FloatRect area);
+    void redrawShown();
+    void drawShown();
+    IntRect cellGroups(IntRect cells, int size);
+    void buildTiles(const Clock &budget);
+    void buildTile(int index);
+    void collectTiles();
+    void finishBuilds();
+    void invalidate();
+};
+
+#endif
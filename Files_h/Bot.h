@@ -0,0 +1,37 @@
+/*
+ * Project: minesweeper
+ * Name: Bot.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the Bot class. Plays minesweeper games on a Board
+ *          without a window by clicking the cells the Solver proves are safe
+ *          and otherwise guessing the cell least likely to be a mine.
+ */
+
+#ifndef BOT_H
+#define BOT_H
+
+#include <vector>
+#include "Board.h"
+#include "Solver.h"
+
+using namespace std;
+
+class Bot
+{
+public:
+
+    /* constructor */
+    Bot();
+
+    /* play functions */
+    bool play(Board &board);
+    vector<Pos> nextMoves(const vector<int> &cells, int rows, int cols, int mines);
+
+private:
+
+    /* solver and the visible board */
+    Solver solver;
+    vector<int> visible;
+};
+
+#endif
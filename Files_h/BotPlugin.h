@@ -0,0 +1,67 @@
+/*
+ * Project: minesweeper
+ * Name: BotPlugin.h
+ * Author: Tygan Chin
+ * Purpose: The C interface between the tournament tool and bots built as
+ *          shared libraries. A bot library exports BOT_PLUGIN_ENTRY, which
+ *          returns its botPlugin. Each turn the bot is handed a view of the
+ *          visible board that points straight at the tool's cells (nothing is
+ *          copied for the bot) and writes the cells it wants to click.
+ * Note: Only plain C types cross the interface, so a bot can be written in
+ *       any language that can build a C shared library. Changes that break
+ *       old bots must increase BOT_PLUGIN_VERSION.
+ */
+
+#ifndef BOTPLUGIN_H
+#define BOTPLUGIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* version of the interface (the tool refuses bots built for another) */
+#define BOT_PLUGIN_VERSION 1
+
+/* name of the function every bot library exports */
+#define BOT_PLUGIN_ENTRY "minesweeperBot"
+
+/* value of a hidden cell in the view (the rest are 0 to 8) */
+#define BOT_HIDDEN (-2)
+
+/* the visible board, valid only during the call it is passed to */
+struct botView {
+    int rows;
+    int cols;
+    int mines;
+    const int *cells;
+};
+
+/* a cell to click */
+struct botMove {
+    int row;
+    int col;
+};
+
+/* 
+ * a bot's functions
+ *      create : Make a bot's state (one per thread, reused between games)
+ *     destroy : Free a state made by create
+ *      choose : Write up to maxMoves clicks into moves for the given board and
+ *               return how many were written (0 gives up the game)
+ */
+struct botPlugin {
+    int version;
+    const char *name;
+    void *(*create)(unsigned seed);
+    void (*destroy)(void *state);
+    int (*choose)(void *state, const struct botView *view, struct botMove *moves, int maxMoves);
+};
+
+/* type of the exported function */
+typedef const struct botPlugin *(*botPluginEntry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
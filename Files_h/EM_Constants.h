@@ -28,6 +28,9 @@ static const string FONT = "Fonts/Copperplate.ttc";
 static const float TEXT_THICKNESS = AREA / 1080000;
 static const float DELAY = 0.25;
 
+/* milliseconds between checks on the analysis while it is running */
+static const int ANALYSIS_POLL_DELAY = 100;
+
 /* sound constants */
 static const int SOUND_EFFECT_DELAY = 3000;
 static const soundInfo MUSIC_WIN    = {"Sounds/winMusic.mp3",  75,  1.0,  true};
@@ -47,38 +50,43 @@ static const spriteInfo BACKGROUND_IMAGE = {"FILE", IMAGE_WIDTH, IMAGE_WIDTH, IM
 static const string WIN_FILES[] = {"History/winsEasy.txt", "History/winsMedium.txt", "History/winsHard.txt"};
 static const Color WIN_TEXT_FILL = GREEN, LOSS_TEXT_FILL = BLACK;
 static const rectangleInfo WIN_NUM_BOX = {WIDTH / 12, WIDTH / 12, WIDTH / 14, HEIGHT / 60, TRANSPARENT, 0, BLACK};
-static const textInfo WIN_NUM_TEXT = {"Wins: ", FONT, AREA / 13500, TRANSPARENT, AREA / 1080000, BLACK};
+static const textInfo WIN_NUM_TEXT = {"Wins: ", FONT, (int)(AREA / 13500), TRANSPARENT, AREA / 1080000, BLACK};
 
 /* difficulty */
 static const string DIFF_TXT[] = {"E", "M", "H"};
 static const Color DIFF_FILL[] = {GREEN, YELLOW, RED};
 static const rectangleInfo DIFF_BOX = {WIDTH / 9, HEIGHT / 6, WIDTH / 1.125, 0, TRANSPARENT, 0, BLACK};
-static const textInfo DIFF_TEXT = {"INITIAL", FONT, AREA / 6250, TRANSPARENT, TEXT_THICKNESS, BLACK};
+static const textInfo DIFF_TEXT = {"INITIAL", FONT, (int)(AREA / 6250), TRANSPARENT, TEXT_THICKNESS, BLACK};
 
 /* Win/Loss */
 static const string WIN_MESSAGE_TEXT = "YOU WON", LOSS_MESSAGE_TEXT = "YOU LOST";
 static const Color WIN_MESSAGE_COLOR = GREEN,     LOSS_MESSAGE_COLOR = RED;
 static const rectangleInfo WIN_LOSS_BOX = {WIDTH, HEIGHT, 0, 0, TRANSPARENT, 0, BLACK};
-static const textInfo WL_TEXT  = {"MESSAGE",  FONT, AREA / 3272.7, GREEN, TEXT_THICKNESS, BLACK};
+static const textInfo WL_TEXT  = {"MESSAGE",  FONT, (int)(AREA / 3272.7), GREEN, TEXT_THICKNESS, BLACK};
 
 /* best time */
 static const string TIMES[] = {"History/bestEasy.txt", "History/bestMedium.txt", "History/bestHard.txt"};
-static const rectangleInfo BEST_TIME_BOX = {WIDTH / 3.6, HEIGHT / 2.4, WIDTH / 1.8, HEIGHT / 1.935, TRANSPARENT, 0, BLACK};
-static const textInfo BEST_TIME_TEXT = {"BEST: ", FONT, AREA / 10800, BLACK, TEXT_THICKNESS, BLACK};
+static const rectangleInfo BEST_TIME_BOX = {(int)(WIDTH / 3.6), (int)(HEIGHT / 2.4), WIDTH / 1.8, HEIGHT / 1.935, TRANSPARENT, 0, BLACK};
+static const textInfo BEST_TIME_TEXT = {"BEST: ", FONT, (int)(AREA / 10800), BLACK, TEXT_THICKNESS, BLACK};
 
 /* curr time */
 static const string TIME_LOSS = "...N/A...";
-static const rectangleInfo TIME_BOX = {WIDTH / 3.6, HEIGHT / 2.4, WIDTH / 6.25, HEIGHT / 1.935, TRANSPARENT, 0, BLACK};
-static const textInfo TIME_TEXT = {"TIME: ", FONT, AREA / 10800, BLACK, TEXT_THICKNESS, BLACK};
+static const rectangleInfo TIME_BOX = {(int)(WIDTH / 3.6), (int)(HEIGHT / 2.4), WIDTH / 6.25, HEIGHT / 1.935, TRANSPARENT, 0, BLACK};
+static const textInfo TIME_TEXT = {"TIME: ", FONT, (int)(AREA / 10800), BLACK, TEXT_THICKNESS, BLACK};
+
+/* game analysis (between the quit and continue buttons) */
+static const string ANALYZING = "ANALYZING MOVE ";
+static const rectangleInfo ANALYSIS_BOX = {(int)(WIDTH - (2 * WIDTH / 4.5)), (int)(HEIGHT / 7.5), WIDTH / 4.5, HEIGHT / 1.154, TRANSPARENT, 0, BLACK};
+static const textInfo ANALYSIS_TEXT = {"ANALYZING...", FONT, (int)(AREA / 27000), BLACK, 0, BLACK};
 
 /* Quit box */
-static const rectangleInfo QUIT_BOX = {WIDTH / 4.5, HEIGHT / 7.5, 0, HEIGHT / 1.154, RED, 0, BLACK};
-static const textInfo QUIT_TEXT = {"QUIT", FONT, AREA / 18000, WHITE, TEXT_THICKNESS, BLACK};
+static const rectangleInfo QUIT_BOX = {(int)(WIDTH / 4.5), (int)(HEIGHT / 7.5), 0, HEIGHT / 1.154, RED, 0, BLACK};
+static const textInfo QUIT_TEXT = {"QUIT", FONT, (int)(AREA / 18000), WHITE, TEXT_THICKNESS, BLACK};
 static const textBoxInfo QUIT_TEXTBOX = {QUIT_BOX, QUIT_TEXT};
 
 /* Continue box */
-static const rectangleInfo CONTINUE_BOX = {WIDTH / 4.5, HEIGHT / 7.5, WIDTH / 1.286, HEIGHT / 1.154, GREEN, 0, BLACK};
-static const textInfo CONTINUE_TEXT = {"PLAY AGAIN", FONT, AREA / 18000, WHITE, TEXT_THICKNESS, BLACK};
+static const rectangleInfo CONTINUE_BOX = {(int)(WIDTH / 4.5), (int)(HEIGHT / 7.5), WIDTH / 1.286, HEIGHT / 1.154, GREEN, 0, BLACK};
+static const textInfo CONTINUE_TEXT = {"PLAY AGAIN", FONT, (int)(AREA / 18000), WHITE, TEXT_THICKNESS, BLACK};
 static const textBoxInfo CONT_TEXTBOX = {CONTINUE_BOX, CONTINUE_TEXT};
 
 #endif
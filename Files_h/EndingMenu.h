@@ -5,8 +5,8 @@
  * Purpose: Interface for the EndingMenu class. Declares the functions that
  *          display the ending menu for the user which includes a win/loss
  *          message, the difficulty of the game, the number of wins on the
- *          difficulty, the time elasped, the best time recorded, and quit
- *          and continue buttons.
+ *          difficulty, the time elasped, the best time recorded, the 
+ *          analysis of the user's moves, and quit and continue buttons.
  */
 
 #ifndef ENDINGMENU_H
@@ -14,6 +14,7 @@
 
 #include "SFML/Graphics.hpp"
 #include "SFMLhelper.h"
+#include "GameAnalysis.h"
 #include <string>
 
 using namespace sf;
@@ -24,7 +25,7 @@ class EndingMenu
 public:
     
     /* constructor */
-    EndingMenu(bool gameWon, Time time, int &difficulty);
+    EndingMenu(bool gameWon, Time time, int &difficulty, GameAnalysis &gameAnalysis);
 
     /* run function */
     bool playAgain();
@@ -38,6 +39,11 @@ private:
     Sprite backgroundImage;
     textBox winNumber, difficultyInitial, winLoss, bestTime, time, quit, cont;
 
+    /* background analysis of the game and the last results displayed */
+    GameAnalysis *analysis;
+    analysisResults analysisShown;
+    textBox analysisText;
+
     /* helper functions */
     bool decision(RenderWindow &window);
     void draw(RenderWindow &window);
@@ -51,6 +57,8 @@ private:
     void setWinLoss(bool &gameWon);
     void setTimes(bool &gameWon, Time &gameTime, int &difficulty);
     bool setBestTime(bool &gameWon, Time &gameTime, string file);
+    bool updateAnalysis();
+    void setAnalysisText();
 
     /* image helper funcs */
     string getWins(bool &gameWon, string filename);
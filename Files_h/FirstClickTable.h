@@ -0,0 +1,55 @@
+/*
+ * Project: minesweeper
+ * Name: FirstClickTable.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the FirstClickTable class. Holds, for every first
+ *          click of every difficulty, how many simulated games the Bot played
+ *          and won from it and how many cells the first click opened. The 
+ *          table is made by the firstclick tool and loaded by the game.
+ */
+
+#ifndef FIRSTCLICKTABLE_H
+#define FIRSTCLICKTABLE_H
+
+#include <vector>
+#include <string>
+#include "Board.h"
+#include "Game_Constants.h"
+
+using namespace std;
+
+/* totals of the games played from one first click */
+struct firstClickStats {
+    long games;
+    long wins;
+    long opened;
+};
+
+class FirstClickTable
+{
+public:
+
+    /* constructor */
+    FirstClickTable();
+
+    /* file functions */
+    bool load(const string &filename);
+    bool save(const string &filename);
+
+    /* add games to the table (tables of separate runs can be added together) */
+    void add(int difficulty, int row, int col, const firstClickStats &stats);
+    void add(const FirstClickTable &other);
+
+    /* getters (the rates are -1 if no games were played from the cell) */
+    firstClickStats getStats(int difficulty, int row, int col);
+    double winRate(int difficulty, int row, int col);
+    double openingSize(int difficulty, int row, int col);
+    Pos bestCell(int difficulty);
+
+private:
+
+    /* the totals of each difficulty (row major by first click) */
+    vector<firstClickStats> cells[NUM_DIFFS];
+};
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Project: minesweeper
+ * Name: GameAnalysis.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the GameAnalysis class. Replays a finished game on
+ *          a background thread, using the Solver to decide whether each click
+ *          was certain to be safe, a guess the user had to make, or a risk
+ *          the user didn't need to take.
+ */
+
+#ifndef GAMEANALYSIS_H
+#define GAMEANALYSIS_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "Board.h"
+#include "FirstClickTable.h"
+
+using namespace std;
+
+/* results of the analysis so far */
+struct analysisResults {
+    int movesAnalyzed, totalMoves;
+    int forcedSafe, necessaryGuesses, unnecessaryRisks;
+    double luck;
+    double lossChance;
+    double firstClickWin, bestFirstClickWin;
+    bool done;
+};
+
+class GameAnalysis
+{
+public:
+
+    /* constructor and destructor */
+    GameAnalysis(Board &board, FirstClickTable &table, int difficulty);
+    ~GameAnalysis();
+
+    /* run functions */
+    void start();
+    void cancel();
+
+    /* getter */
+    analysisResults getResults();
+
+private:
+
+    /* the finished game */
+    int numRows;
+    int numCols;
+    vector<Pos> mines;
+    vector<Pos> moves;
+
+    /* worker thread and the results it shares with the menu */
+    thread worker;
+    mutex resultsLock;
+    atomic<bool> cancelled;
+    analysisResults results;
+
+    /* helper function */
+    void run();
+};
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Project: minesweeper
+ * Name: GameRecord.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the GameRecord class. Holds a played game (its
+ *          difficulty, where the mines were, and every click with the time it
+ *          was made) so the game can be replayed on a Board later. The game
+ *          saves its last game and the gamevideo tool turns one into frames.
+ */
+
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <vector>
+#include <string>
+#include "Board.h"
+#include "Game_Constants.h"
+
+using namespace std;
+
+/* a click on a cell (a reveal or a flag) and when it was made, in
+   milliseconds from the start of the game */
+struct recordedMove {
+    long time;
+    bool flag;
+    int row;
+    int col;
+};
+
+class GameRecord
+{
+public:
+
+    /* constructor */
+    GameRecord();
+
+    /* recording */
+    void start(int difficulty);
+    void add(long time, bool flag, int row, int col);
+    void finish(long time, const vector<Pos> &mines);
+
+    /* file functions */
+    bool load(const string &filename);
+    bool save(const string &filename);
+
+    /* replaying */
+    void deal(Board &board);
+    void play(Board &board, const recordedMove &move);
+
+    /* getters */
+    int getDifficulty();
+    long getLength();
+    const vector<recordedMove> &getMoves();
+
+private:
+
+    /* the game's difficulty, length in milliseconds and mines */
+    int diff;
+    long length;
+    vector<Pos> mines;
+
+    /* every click, in the order they were made */
+    vector<recordedMove> moves;
+};
+
+#endif
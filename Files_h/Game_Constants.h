@@ -11,7 +11,6 @@
 #define GAME_CONSTANTS_H
 
 #include <string>
-#include "SFMLhelper.h"
 
 using namespace std;
 
@@ -26,6 +25,17 @@ static const int GAME_WIDTH = 800;
 /* number of difficulties in the game */
 static const int NUM_DIFFS  = 3;
 
+/* board dimensions and number of bombs of each difficulty */
+static const int EASY_COLS  =  8, MEDIUM_COLS  = 16,  HARD_COLS  = 30;
+static const int EASY_ROWS  =  8, MEDIUM_ROWS  = 16,  HARD_ROWS  = 16;
+static const int EASY_BOMBS = 10, MEDIUM_BOMBS = 40,  HARD_BOMBS = 99;
+
+/* the same values indexed by difficulty (for programs without the menus) */
+static const int DIFF_COLS[]     = {EASY_COLS, MEDIUM_COLS, HARD_COLS};
+static const int DIFF_ROWS[]     = {EASY_ROWS, MEDIUM_ROWS, HARD_ROWS};
+static const int DIFF_BOMBS[]    = {EASY_BOMBS, MEDIUM_BOMBS, HARD_BOMBS};
+static const string DIFF_NAMES[] = {"easy", "medium", "hard"};
+
 /* move outcomes */
 static const int NUMBERED_SPACE =  2;
 static const int OPEN_SPACE     =  1;
@@ -35,7 +45,26 @@ static const int NO_SPACE       =  0;
 /* mine value */
 static const int MINE = -1;
 
-/* button sound info */
-static const soundInfo BUTTON = {"Sounds/button.mp3", 100, 1.0, false};
+/* cells this close to the first move (in rows and columns) never have bombs */
+static const int SAFE_RADIUS = 2;
+
+/* deal boards that can be solved without guessing (slower to deal), by
+   default or when the game is run with the flag */
+static const bool NO_GUESS_MODE = false;
+static const string NO_GUESS_FLAG = "--no-guess";
+
+/* draw the grid with a shader (where shaders work) instead of the vertex
+   tiles, by default or when the game is run with the flag */
+static const bool SHADER_GRID = false;
+static const string SHADER_FLAG = "--shader";
+
+/* bot win rates of every first click (made by the firstclick tool) */
+static const string FIRST_CLICK_TABLE = "Positions/firstClick.txt";
+
+/* value of a cell that has not been revealed to the user */
+static const int HIDDEN = -2;
+
+/* value of a hidden cell the user put a flag on (see Board::getDrawn) */
+static const int FLAGGED = -3;
 
 #endif
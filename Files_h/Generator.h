@@ -0,0 +1,65 @@
+/*
+ * Project: minesweeper
+ * Name: Generator.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the Generator class. Deals boards that can be solved
+ *          from the first move without ever guessing. Candidate boards are
+ *          dealt and checked on several threads at once and the first board
+ *          proven solvable is used.
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include "Board.h"
+
+using namespace std;
+
+class Generator
+{
+public:
+
+    /* constructor */
+    Generator();
+
+    /* number of threads to deal boards on (every core by default) */
+    void setWorkers(unsigned workers);
+
+    /* generate the mine locations of a board that needs no guessing */
+    vector<Pos> generate(int rows, int cols, int mines, Pos firstMove, unsigned seed);
+    void cancel();
+
+    /* check whether a given board needs no guessing */
+    bool isSolvable(int rows, int cols, Pos firstMove, const vector<Pos> &mines);
+
+    /* getter */
+    generatorStats getStats();
+
+private:
+
+    /* the board being generated */
+    int numRows;
+    int numCols;
+    int numMines;
+    Pos first;
+    unsigned numWorkers;
+
+    /* shared between the workers */
+    atomic<bool> found;
+    atomic<bool> cancelled;
+    atomic<long> tried;
+    atomic<long> rejected;
+    mutex resultLock;
+    vector<Pos> result;
+    generatorStats stats;
+
+    /* helper functions */
+    void work(unsigned seed);
+    bool solvable(const vector<Pos> &mines);
+    bool stopped();
+};
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Project: minesweeper
+ * Name: LaneSim.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the LaneSim class. Plays SIM_LANES games side by side
+ *          on boards of at most 64 cells, storing each game's mines, revealed
+ *          cells, flags and numbers as one 64 bit word per plane so the
+ *          reveals, deductions and win checks of every game run together.
+ */
+
+#ifndef LANESIM_H
+#define LANESIM_H
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/* games played side by side (one per lane) */
+static const int SIM_LANES = 8;
+
+/* bits in a board plane (boards must fit in one word) */
+static const int PLANE_BITS = 64;
+
+/* bits needed to count up to the 8 neighbors of a cell */
+static const int COUNT_BITS = 4;
+
+/* the totals of some simulated games */
+struct laneResults {
+    long games;
+    long wins;
+    long guesses;
+};
+
+class LaneSim
+{
+public:
+
+    /* constructor */
+    LaneSim(int rows, int cols, int mines);
+
+    /* play games first through first + games - 1 (game i is dealt by seed + i) */
+    laneResults run(long first, long games, uint64_t seed);
+
+private:
+
+    /* board size and the planes that mask it */
+    int numRows;
+    int numCols;
+    int numMines;
+    uint64_t boardMask;
+    int shifts[8];
+    uint64_t shiftMasks[8];
+    vector<int> allowed;
+    vector<int> shuffled;
+    int firstCell;
+
+    /* one word per lane for each plane */
+    uint64_t mines[SIM_LANES];
+    uint64_t zeros[SIM_LANES];
+    uint64_t number[COUNT_BITS][SIM_LANES];
+    uint64_t shown[SIM_LANES];
+    uint64_t flags[SIM_LANES];
+    uint64_t clicks[SIM_LANES];
+
+    /* whether each lane has a game and its random state */
+    bool active[SIM_LANES];
+    uint64_t random[SIM_LANES];
+
+    /* scratch planes */
+    uint64_t scratch[SIM_LANES];
+    uint64_t counts[COUNT_BITS][SIM_LANES];
+
+    /* helper functions */
+    void deal(int lane, long index, uint64_t seed);
+    void reveal();
+    void deduce(uint64_t *safe, uint64_t *newFlags);
+    void dilate(const uint64_t *plane, uint64_t *result);
+    void count(const uint64_t *plane, uint64_t result[COUNT_BITS][SIM_LANES]);
+    void equal(uint64_t a[COUNT_BITS][SIM_LANES], uint64_t b[COUNT_BITS][SIM_LANES], uint64_t *result);
+    uint64_t shift(uint64_t plane, int dir);
+    int pickBit(uint64_t plane, uint64_t &state);
+};
+
+#endif
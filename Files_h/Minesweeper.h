@@ -10,6 +10,12 @@
 #include "SFML/Audio.hpp"
 #include "SFMLhelper.h"
 #include "Board.h"
+#include "BoardPool.h"
+#include "FirstClickTable.h"
+#include "BoardRenderer.h"
+#include "SnapshotBuffer.h"
+#include "GameRecord.h"
+#include <atomic>
 
 using namespace std;
 using namespace sf;
@@ -18,17 +24,31 @@ class Minesweeper
 {
 public:
 
-    /* constructor */
-    Minesweeper();
+    /* constructors (the second draws boards off screen, without the menus,
+       a window or sound) */
+    Minesweeper(BoardPool &pool, FirstClickTable &table, bool noGuess,
+                bool shader);
+    Minesweeper(int level);
 
     /* run function */
     bool run();
+
+    /* frame latency of the last game (from a snapshot of the board being
+       published to being on screen) */
+    Time averageLatency();
+    Time worstLatency();
+
+    /* off screen drawing (see the boardshots tool) */
+    Vector2u frameSize();
+    void drawBoard(RenderTarget &target, Board &board, Time currTime);
     
 private:
 
-    /* game board */
+    /* game board and the record of the game's clicks */
     Board gameBoard;
     int difficulty;
+    FirstClickTable *firstClicks;
+    GameRecord record;
 
     /* window */
     SFMLhelper SFML;
@@ -44,44 +64,62 @@ private:
     Sound flag_sound;
     Sound cellReveal;
 
-    /* text and rectangles */
+    /* text */
     textBox title;
     textBox time;
     textBox flag_amount;
-    RectangleShape shown_cell_box;
-    RectangleShape not_shown_cell_box;
-    RectangleShape end_animation_cell;
     Text cellNums[8];
 
+    /* the grid of cells, whether a shader draws it and the view it is
+       drawn through (zoom and pan) */
+    BoardRenderer grid;
+    bool shaderGrid;
+    View boardView;
+    Vector2f boardSize;
+    bool panning;
+    Vector2i panFrom;
+
+    /* snapshots of the board for the render thread, whether it should keep
+       running and its frame latency */
+    SnapshotBuffer snapshots;
+    atomic<bool> rendering;
+    Time latencyTotal;
+    Time latencyWorst;
+    long latencyFrames;
+
     /* images */
     Sprite flag_in_title;
-    Sprite cell_flag;
-    Sprite end_animation_image;
+
+    /* the title and title flag, drawn once */
+    RenderTexture titleLayer;
+    Sprite titleSprite;
 
     /* game helper funcs */
     Time runGame(RenderWindow &window);
-    bool gameMove(RenderWindow &window);
-    void placeFlag(RenderWindow &window);
-    bool invalidCell(Vector2i &mousePos);
+    void renderLoop(RenderWindow &window);
+    void publish(Time time);
+    bool gameMove(RenderWindow &window, Time moment);
+    void placeFlag(RenderWindow &window, Time moment);
+    bool findCell(RenderWindow &window, int &row, int &col);
+    bool moveCamera(RenderWindow &window, Event event);
     void drawGame(RenderWindow &window, Time currTime);
+    void drawFrame(RenderTarget &target, const BoardSnapshot &shot, Time currTime);
 
     /* end animation funcs */
     void endAnimation(RenderWindow &window, Time time);
-    bool windowExit(RenderWindow &window, Event event);
-    bool reveal(RenderWindow &window, Time time);
 
     /* set image functions */
+    void setDifficulty();
     void setImagesAndAudio();
+    void setImages();
     void setWindowDimensions();
     void setFlags();
+    void setTitleLayer();
     void setCellBox();
     void setCellText_numbers();
     void setCellText_flags();
     void setAnimationImages();
 
     /* draw image funtions */
-    void drawGrid(RenderWindow &window);
-    void drawCell(RenderWindow &window, int &row, int &col);
-    void drawOpenCell(RenderWindow &window, RectangleShape &cell, int &row, int &col);
-    void drawCellFlag(RenderWindow &window, RectangleShape &cell, int &row, int &col);
+    void drawGrid(RenderTarget &target, const BoardSnapshot &shot);
 };
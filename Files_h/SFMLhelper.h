@@ -80,9 +80,13 @@ static const Color CYAN         = Color::Cyan;
 static const Color MAGENTA      = Color::Magenta;
 static const Color TRANSPARENT  = Color::Transparent;
 
-/* delay length (in seconds) for a button sound */
+/* button sound info and delay length (in seconds) for a button sound */
+static const soundInfo BUTTON = {"Sounds/button.mp3", 100, 1.0, false};
 static const float BUTTON_DELAY = 0.25;
 
+/* milliseconds between checks for events while waiting with a timeout */
+static const int EVENT_WAIT_SLICE = 10;
+
 class SFMLhelper 
 {
 public: 
@@ -90,7 +94,7 @@ public:
     /* TextBox Funcs */
     textBox makeTextBox(textBoxInfo tboxData);
     textBox makeTextBox(rectangleInfo rectangleData, textInfo textData);
-    void drawTextBox(RenderWindow &window, textBox &tBox);
+    void drawTextBox(RenderTarget &window, textBox &tBox);
 
     /* RectangleShape Funcs */
     Rectangle createRec(rectangleInfo rectData);
@@ -113,6 +117,9 @@ public:
     /* User Input Funcs */
     bool leftClick(Event event);
     bool SpacebarPressed(Event event);
+    bool SpacebarReleased(Event event);
+    bool waitEvent(RenderWindow &window, Event &event, Time timeout);
+    bool needsRedraw(Event event);
 
     /* Time Funcs */
     string getTime(Time time);
@@ -31,8 +31,8 @@ static const soundInfo MUSIC  = {"Sounds/startingMusic.wav",  100, 1.0, true};
 
 /* title */
 static const float TITLE_HEIGHT      = HEIGHT / 3;
-static const rectangleInfo TITLE_BOX = {WIDTH, TITLE_HEIGHT, 0, 0, WHITE, 0, BLACK};
-static const textInfo TITLE_TEXT     = {"MINESWEEPER", FONT, AREA / 7714.2, BLACK,  0, BLACK};
+static const rectangleInfo TITLE_BOX = {(int)WIDTH, (int)TITLE_HEIGHT, 0, 0, WHITE, 0, BLACK};
+static const textInfo TITLE_TEXT     = {"MINESWEEPER", FONT, (int)(AREA / 7714.2), BLACK,  0, BLACK};
 static const textBoxInfo TITLE       = {TITLE_BOX, TITLE_TEXT};
 
 /* difficulty buttons */
@@ -51,7 +51,7 @@ static const float EASY_XPOS         = 0;
 static const Color EASY_RECT_COLOR   = Color(0, 200, 0);
 static const string EASY_TXT         = "EASY";
 static const rectangleInfo EASY_RECT = {DIFF_WIDTH, DIFF_HEIGHT, EASY_XPOS, DIFF_YPOS, EASY_RECT_COLOR, RECT_THICKNESS, RECT_OUTLINE};
-static const textInfo EASY_TEXT      = {EASY_TXT, FONT, FONT_SIZE, TEXT_COLOR, TEXT_THICKNESS, TEXT_OUTLINE};
+static const textInfo EASY_TEXT      = {EASY_TXT, FONT, (int)FONT_SIZE, TEXT_COLOR, TEXT_THICKNESS, TEXT_OUTLINE};
 static const textBoxInfo EASY        = {EASY_RECT, EASY_TEXT};
 
 /* medium difficulty button */
@@ -59,7 +59,7 @@ static const float MED_XPOS          = DIFF_WIDTH;
 static const Color MED_RECT_COLOR    = Color(255, 255, 0);
 static const string MED_TXT          = "MEDIUM";
 static const rectangleInfo MED_RECT  = {DIFF_WIDTH, DIFF_HEIGHT, MED_XPOS, DIFF_YPOS, MED_RECT_COLOR, RECT_THICKNESS, RECT_OUTLINE};
-static const textInfo MED_TEXT       = {MED_TXT, FONT, FONT_SIZE, TEXT_COLOR, TEXT_THICKNESS, TEXT_OUTLINE};
+static const textInfo MED_TEXT       = {MED_TXT, FONT, (int)FONT_SIZE, TEXT_COLOR, TEXT_THICKNESS, TEXT_OUTLINE};
 static const textBoxInfo MEDIUM      = {MED_RECT, MED_TEXT};
 
 /* hard difficulty button */
@@ -67,7 +67,7 @@ static const float HARD_XPOS         = DIFF_WIDTH * 2;
 static const Color HARD_RECT_COLOR   = Color(200, 0, 0);
 static const string HARD_TXT         = "HARD";
 static const rectangleInfo HARD_RECT = {DIFF_WIDTH, DIFF_HEIGHT, HARD_XPOS, DIFF_YPOS, HARD_RECT_COLOR, RECT_THICKNESS, RECT_OUTLINE};
-static const textInfo HARD_TEXT      = {HARD_TXT,  FONT, FONT_SIZE, TEXT_COLOR, TEXT_THICKNESS, TEXT_OUTLINE};
+static const textInfo HARD_TEXT      = {HARD_TXT,  FONT, (int)FONT_SIZE, TEXT_COLOR, TEXT_THICKNESS, TEXT_OUTLINE};
 static const textBoxInfo HARD        = {HARD_RECT, HARD_TEXT};
 
 /* array of difficulty text boxes */
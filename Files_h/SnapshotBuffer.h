@@ -0,0 +1,92 @@
+/*
+ * Project: minesweeper
+ * Name: SnapshotBuffer.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the SnapshotBuffer class. Hands copies of the board
+ *          as the user sees it from the thread playing the game to the
+ *          thread drawing it. Each side has its own snapshot and a third is
+ *          passed between them with one atomic swap, so neither side ever
+ *          waits on the other or sees a snapshot being written. Each
+ *          snapshot's cells are kept up to date by copying only the cells
+ *          that changed since it was last written, so publishing a new view
+ *          of an unchanged board copies nothing. The reader can sleep until
+ *          the next snapshot is published.
+ */
+
+#ifndef SNAPSHOTBUFFER_H
+#define SNAPSHOTBUFFER_H
+
+#include "SFML/Graphics.hpp"
+#include "Board.h"
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+using namespace sf;
+
+/* the board and what's drawn around it at one moment of the game */
+struct BoardSnapshot {
+    int rows;
+    int cols;
+    vector<int> cells;
+    vector<Pos> changed;
+    unsigned long sequence;
+    int flagsLeft;
+    Time time;
+    View view;
+    Clock published;
+};
+
+class SnapshotBuffer
+{
+public:
+
+    /* constructor */
+    SnapshotBuffer();
+
+    /* writer side (the game) */
+    BoardSnapshot &back();
+    void capture(Board &board);
+    void publish();
+    void restart();
+    void wake();
+
+    /* reader side (the renderer) */
+    bool take();
+    const BoardSnapshot &front();
+    bool wait(Time timeout);
+
+private:
+
+    /* the writer's, the reader's and the shared snapshot (its index, and
+       whether it was published since the reader last took one) */
+    BoardSnapshot slots[3];
+    int writing;
+    int reading;
+    atomic<int> shared;
+
+    /* cells changed since the last snapshot the reader is known to have
+       taken, and how many of them the last published snapshot had */
+    vector<Pos> unseen;
+    size_t lastPublished;
+    unsigned long published;
+
+    /* every change since the one each snapshot's cells are current up to
+       (history[0] is change number historyStart), and that change for each
+       snapshot (STALE_SLOT if its cells must be copied whole) */
+    vector<Pos> history;
+    size_t historyStart;
+    size_t current[3];
+
+    /* wakes the reader when a snapshot is published or wake is called */
+    mutex wakeLock;
+    condition_variable wakeUp;
+    bool woken;
+
+    /* helper funcs */
+    void trimHistory(size_t limit);
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Project: minesweeper
+ * Name: Solver.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the Solver class. Defines functions that find the
+ *          cells that are certain to be safe or mines and the probability of
+ *          every other hidden cell being a mine, given only the cells the
+ *          user can see.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <vector>
+#include <atomic>
+#include "Board.h"
+#include "Game_Constants.h"
+
+using namespace std;
+
+class Solver
+{
+public:
+
+    /* constructor */
+    Solver();
+
+    /* solve the visible board (see Board::getVisible) */
+    void solve(const vector<int> &cells, int rows, int cols, int mines);
+    void solveSimple(const vector<int> &cells, int rows, int cols, int mines);
+
+    /* stop counting early once the flag is set (see setCancel) */
+    void setCancel(const atomic<bool> *flag);
+
+    /* getters */
+    bool isSafe(int row, int col);
+    bool isMine(int row, int col);
+    double mineProbability(int row, int col);
+    vector<Pos> safeCells();
+    Pos bestGuess();
+    bool exact();
+
+private:
+
+    /* a number on the board and the hidden cells around it */
+    struct Constraint {
+        int mines;
+        vector<int> vars;
+    };
+
+    /* a group of hidden cells linked together by shared constraints */
+    struct Component {
+        vector<int> vars;
+        vector<int> constraints;
+        vector<double> solutions;
+        vector<vector<double> > mineCounts;
+    };
+
+    /* the visible board */
+    vector<int> board;
+    int numRows;
+    int numCols;
+    int numMines;
+
+    /* results */
+    vector<int> state;
+    vector<double> probability;
+    bool allExact;
+
+    /* working storage for the search */
+    vector<Constraint> constraints;
+    vector<Component> components;
+    vector<vector<int> > cellConstraints;
+    vector<int> assignment;
+    vector<int> placed;
+    vector<int> unassigned;
+    long nodes;
+    const atomic<bool> *cancel;
+
+    /* helper functions */
+    void reset(const vector<int> &cells, int rows, int cols, int mines);
+    void deduce();
+    void buildComponents();
+    bool enumerate(Component &comp);
+    void search(Component &comp, size_t index, int mines);
+    bool consistent(int var);
+    void combine();
+    void setCertain(int cell, int value, vector<int> &queue);
+    int neighbors(int cell, int *adjacent);
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Project: minesweeper
+ * Name: TerminalRenderer.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the TerminalRenderer class. Draws a Board in a
+ *          terminal with ANSI escape sequences, without SFML. Only the cells
+ *          in the board's change log whose look changed, and the status or
+ *          message line if its text changed, are written again, and each
+ *          frame is sent with one write, so a frame costs a few bytes over a
+ *          slow connection and nothing at all when nothing changed.
+ */
+
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include <vector>
+#include <string>
+#include "Board.h"
+
+using namespace std;
+
+class TerminalRenderer
+{
+public:
+
+    /* constructor */
+    TerminalRenderer();
+
+    /* initializer (must be called before drawing) */
+    void setBoard(int rows, int cols);
+
+    /* draw the whole screen on the next frame (after a resize or when the
+       screen may have been written over) */
+    void invalidate();
+
+    /* draw function (leaves the terminal's cursor on the given cell) */
+    bool draw(Board &board, Pos cursor, const string &status, const string &message);
+
+private:
+
+    /* the board's size, and how each cell, the status and the message were
+       last drawn */
+    int numRows;
+    int numCols;
+    vector<int> drawn;
+    string drawnStatus;
+    string drawnMessage;
+    bool stale;
+
+    /* the board as it is now and the cells that changed since last frame */
+    vector<int> cells;
+    vector<Pos> changed;
+
+    /* the frame being built, and where the terminal's cursor will be and
+       which colors are on once it is written */
+    string frame;
+    int cursorLine;
+    int cursorColumn;
+    string color;
+
+    /* helper funcs */
+    void writeCell(int row, int col);
+    void writeLine(int line, const string &text, string &last);
+    void moveTo(int line, int column);
+    void setColor(const string &code);
+    bool flush();
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Project: minesweeper
+ * Name: TextureAtlas.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the TextureAtlas class. Packs several images into
+ *          one texture so everything drawn from them can be drawn at once.
+ *          Each image added gets an id used to look up where it was placed.
+ */
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include "SFML/Graphics.hpp"
+#include <vector>
+
+using namespace std;
+using namespace sf;
+
+class TextureAtlas
+{
+public:
+
+    /* constructor */
+    TextureAtlas();
+
+    /* add images (returns the image's id) */
+    int add(const Image &image);
+    int addScaled(const Image &image, unsigned width, unsigned height);
+    int addColor(Color color);
+    void clear();
+
+    /* pack the images into the texture */
+    bool build();
+
+    /* getters */
+    const Texture &getTexture() const;
+    FloatRect getRect(int id) const;
+
+private:
+
+    /* the images waiting to be packed, whether each is a block added by
+       addColor, and where each was placed */
+    vector<Image> images;
+    vector<bool> colorBlocks;
+    vector<FloatRect> rects;
+    Texture texture;
+};
+
+#endif
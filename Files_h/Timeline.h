@@ -0,0 +1,59 @@
+/*
+ * Project: minesweeper
+ * Name: Timeline.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the Timeline class. Schedules actions at set times
+ *          on a timeline that follows the frame clock, so an animation can
+ *          sleep until its next step instead of polling, and be sped up or
+ *          skipped to the end.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "SFML/System.hpp"
+#include <vector>
+#include <functional>
+
+using namespace std;
+using namespace sf;
+
+class Timeline
+{
+public:
+
+    /* constructor */
+    Timeline();
+
+    /* schedule an action (times are from the start of the timeline) */
+    void at(Time when, const function<void()> &action);
+
+    /* playback */
+    void update();
+    void setSpeed(float speed);
+    void skip();
+
+    /* getters */
+    Time untilNext();
+    bool done();
+
+private:
+
+    /* an action and when it runs */
+    struct Cue {
+        Time when;
+        function<void()> action;
+    };
+
+    /* the actions in the order they run and the next one to run */
+    vector<Cue> cues;
+    size_t next;
+
+    /* how far the timeline has played, the real time since the last update
+       and how many times faster than real time it plays */
+    Time position;
+    Clock clock;
+    float playSpeed;
+};
+
+#endif
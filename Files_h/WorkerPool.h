@@ -0,0 +1,56 @@
+/*
+ * Project: minesweeper
+ * Name: WorkerPool.h
+ * Author: Tygan Chin
+ * Purpose: Interface for the WorkerPool class. Keeps a set of threads
+ *          waiting for tasks so work can be split across the cores without
+ *          starting a thread for every piece of it.
+ */
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+using namespace std;
+
+class WorkerPool
+{
+public:
+
+    /* constructor and destructor */
+    WorkerPool();
+    ~WorkerPool();
+
+    /* run functions */
+    void start(unsigned workers);
+    void stop();
+    unsigned size();
+
+    /* queue a task and wait for every queued task to finish */
+    void submit(const function<void()> &task);
+    void wait();
+
+private:
+
+    /* the threads and the tasks waiting for them */
+    vector<thread> threads;
+    deque<function<void()> > tasks;
+
+    /* state shared with the threads */
+    mutex poolLock;
+    condition_variable taskAdded;
+    condition_variable tasksDone;
+    int running;
+    bool stopped;
+
+    /* helper function */
+    void work();
+};
+
+#endif
@@ -0,0 +1,346 @@
+/*
+ * Project: minesweeper
+ * Name: BoardCorpus.cpp
+ * Author: Tygan Chin
+ * Purpose: Builds and checks corpora of boards for regression testing Board.
+ *          generate deals boards with Board on every core, each from its own
+ *          seed and a first click picked from that seed, and writes them to a
+ *          corpus file. verify maps a corpus into memory and checks every
+ *          board on every core: the mine count, that the first click is on 
+ *          the board and has no mines near it, and (optionally) that the 
+ *          board can be solved without guessing. Both report boards per 
+ *          second.
+ * Format: A corpusHeader, then one record per board: the first click's row
+ *         and column (one byte each) followed by the mines as a bitmap of the
+ *         cells in row major order (bit i of byte i / 8). Every record is the
+ *         same size so each core can work on its own range of the file.
+ * Usage: ./boardcorpus generate <file> <boards> <rows> <cols> <mines> [seed]
+ *        ./boardcorpus verify <file> [solvable]
+ */
+
+#include "../Files_h/Board.h"
+#include "../Files_h/Generator.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+/* start of a corpus file */
+struct corpusHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t mines;
+    uint64_t boards;
+    uint64_t seed;
+};
+
+static const char CORPUS_MAGIC[8] = {'M', 'S', 'C', 'O', 'R', 'P', 'U', 'S'};
+static const uint32_t CORPUS_VERSION = 1;
+
+/* boards dealt between writes (bounds the memory used by generate) */
+static const long CHUNK = 1 << 16;
+
+/* failing boards to list */
+static const int MAX_LISTED = 10;
+
+/*
+ * recordSize
+ * purpose: Find the size of a board's record
+ * parameters:
+ *      int rows : Number of rows on the board
+ *      int cols : Number of columns on the board
+ * returns: The size in bytes
+ */
+size_t recordSize(int rows, int cols)
+{
+    return 2 + (((rows * cols) + 7) / 8);
+}
+
+/*
+ * runThreads
+ * purpose: Split a range of boards into one piece per core and run a function
+ *          on each piece
+ * parameters:
+ *                            long first : The first board
+ *                            long count : Number of boards
+ *      void (*job)(long, long, void *) : Called with each piece's first board,
+ *                                        its end, and data
+ *                            void *data : Passed to job
+ * returns: n/a
+ */
+void runThreads(long first, long count, void (*job)(long, long, void *), void *data)
+{
+    long threads = max(1u, thread::hardware_concurrency());
+    vector<thread> workers;
+    for (long i = 0; i < threads; ++i) {
+        long begin = first + ((count * i) / threads);
+        long end = first + ((count * (i + 1)) / threads);
+        workers.push_back(thread(job, begin, end, data));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+
+/******************************************************\
+ *                      Generate                       *
+\******************************************************/
+
+/* a chunk of boards being dealt */
+struct generateJob {
+    corpusHeader header;
+    long chunkStart;
+    vector<uint8_t> records;
+};
+
+/*
+ * dealBoards
+ * purpose: Deal a range of boards into the chunk's records
+ * parameters:
+ *      long begin : The first board
+ *        long end : One past the last board
+ *      void *data : The generateJob
+ * returns: n/a
+ * note: Runs on a worker thread. Each worker writes its own records.
+ */
+void dealBoards(long begin, long end, void *data)
+{
+    generateJob *job = static_cast<generateJob *>(data);
+    int rows = job->header.rows, cols = job->header.cols;
+    size_t size = recordSize(rows, cols);
+    for (long i = begin; i < end; ++i) {
+
+        /* pick the first click and deal the board from the board's seed */
+        unsigned seed = job->header.seed + i;
+        mt19937 gen(seed);
+        int first = uniform_int_distribution<>(0, (rows * cols) - 1)(gen);
+        Board board;
+        board.setSeed(seed);
+        board.setBoard(cols, rows, job->header.mines);
+        board.move(first / cols, first % cols);
+
+        /* write the record */
+        uint8_t *record = &job->records[(i - job->chunkStart) * size];
+        memset(record, 0, size);
+        record[0] = first / cols;
+        record[1] = first % cols;
+        vector<Pos> mines = board.getMines();
+        for (size_t j = 0; j < mines.size(); ++j) {
+            int cell = (mines[j].first * cols) + mines[j].second;
+            record[2 + (cell / 8)] |= 1 << (cell % 8);
+        }
+    }
+}
+
+/*
+ * generate
+ * purpose: Deal boards and write them to a corpus
+ * parameters: See usage above
+ * returns: 0 if the corpus was written, 1 otherwise
+ */
+int generate(int argc, char *argv[])
+{
+    if (argc < 7) {
+        cerr << "usage: ./boardcorpus generate <file> <boards> <rows> <cols> <mines> [seed]" << endl;
+        return 1;
+    }
+    generateJob job;
+    memcpy(job.header.magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC));
+    job.header.version = CORPUS_VERSION;
+    job.header.boards = max(1L, atol(argv[3]));
+    job.header.rows = atoi(argv[4]);
+    job.header.cols = atoi(argv[5]);
+    job.header.mines = atoi(argv[6]);
+    job.header.seed = (argc > 7) ? atol(argv[7]) : 1;
+    int rows = job.header.rows, cols = job.header.cols, mines = job.header.mines;
+    int safe = (2 * SAFE_RADIUS) + 1;
+    if ((rows < 1) or (rows > 255) or (cols < 1) or (cols > 255) or (mines < 1) or
+        (mines > (rows * cols) - (safe * safe))) {
+        cerr << "rows and columns must be 1 to 255 and the mines must fit" << endl;
+        return 1;
+    }
+
+    ofstream output(argv[2], ios::binary);
+    if (not output.is_open()) {
+        cerr << "could not write " << argv[2] << endl;
+        return 1;
+    }
+    output.write(reinterpret_cast<const char *>(&job.header), sizeof(job.header));
+
+    /* deal a chunk on every core, then write it in one piece */
+    size_t size = recordSize(rows, cols);
+    long boards = job.header.boards;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (job.chunkStart = 0; job.chunkStart < boards; job.chunkStart += CHUNK) {
+        long count = min(CHUNK, boards - job.chunkStart);
+        job.records.resize(count * size);
+        runThreads(job.chunkStart, count, dealBoards, &job);
+        output.write(reinterpret_cast<const char *>(job.records.data()), job.records.size());
+    }
+    output.close();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (not output.good()) {
+        cerr << "could not write " << argv[2] << endl;
+        return 1;
+    }
+    cout << boards << " boards (" << rows << "x" << cols << ", " << mines << " mines) in "
+         << fixed << setprecision(2) << elapsed.count() << " s, " << setprecision(0)
+         << boards / elapsed.count() << " boards/s" << endl;
+    return 0;
+}
+
+
+/******************************************************\
+ *                       Verify                        *
+\******************************************************/
+
+/* the mapped corpus and the results of checking it */
+struct verifyJob {
+    const corpusHeader *header;
+    const uint8_t *records;
+    bool checkSolvable;
+    atomic<long> failed;
+    atomic<long> unsolvable;
+    atomic<int> listed;
+};
+
+/*
+ * checkBoards
+ * purpose: Check a range of boards in the corpus
+ * parameters:
+ *      long begin : The first board
+ *        long end : One past the last board
+ *      void *data : The verifyJob
+ * returns: n/a
+ * note: Runs on a worker thread. Only reads the mapped file.
+ */
+void checkBoards(long begin, long end, void *data)
+{
+    verifyJob *job = static_cast<verifyJob *>(data);
+    int rows = job->header->rows, cols = job->header->cols;
+    size_t size = recordSize(rows, cols);
+    Generator generator;
+    for (long i = begin; i < end; ++i) {
+        const uint8_t *record = job->records + (i * size);
+        int firstRow = record[0], firstCol = record[1];
+
+        /* read the mines, checking that none are close to the first click */
+        vector<Pos> mines;
+        bool valid = (firstRow < rows) and (firstCol < cols);
+        for (int cell = 0; cell < rows * cols; ++cell) {
+            if (record[2 + (cell / 8)] & (1 << (cell % 8))) {
+                int row = cell / cols, col = cell % cols;
+                mines.push_back(make_pair(row, col));
+                valid = valid and not ((abs(row - firstRow) <= SAFE_RADIUS) and (abs(col - firstCol) <= SAFE_RADIUS));
+            }
+        }
+        valid = valid and (mines.size() == job->header->mines);
+
+        /* report the failures */
+        bool solvable = (not valid) or (not job->checkSolvable) or
+                        generator.isSolvable(rows, cols, make_pair(firstRow, firstCol), mines);
+        job->failed += not valid;
+        job->unsolvable += not solvable;
+        if (((not valid) or (not solvable)) and (job->listed++ < MAX_LISTED)) {
+            cerr << "board " << i << (valid ? " needs a guess" : " is invalid") << endl;
+        }
+    }
+}
+
+/*
+ * verify
+ * purpose: Check every board of a corpus
+ * parameters: See usage above
+ * returns: 0 if every board passed, 1 otherwise
+ */
+int verify(int argc, char *argv[])
+{
+    if (argc < 3) {
+        cerr << "usage: ./boardcorpus verify <file> [solvable]" << endl;
+        return 1;
+    }
+
+    /* map the file */
+    int fd = open(argv[2], O_RDONLY);
+    struct stat info;
+    if ((fd < 0) or (fstat(fd, &info) != 0) or ((size_t)info.st_size < sizeof(corpusHeader))) {
+        cerr << "could not read " << argv[2] << endl;
+        return 1;
+    }
+    void *mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        cerr << "could not map " << argv[2] << endl;
+        return 1;
+    }
+    madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+
+    /* check the header and the size of the file */
+    verifyJob job;
+    job.header = static_cast<const corpusHeader *>(mapped);
+    job.records = static_cast<const uint8_t *>(mapped) + sizeof(corpusHeader);
+    job.checkSolvable = (argc > 3) and (string(argv[3]) == "solvable");
+    job.failed = job.unsolvable = 0;
+    job.listed = 0;
+    const corpusHeader &header = *job.header;
+    size_t expected = sizeof(corpusHeader) + (header.boards * recordSize(header.rows, header.cols));
+    if ((memcmp(header.magic, CORPUS_MAGIC, sizeof(CORPUS_MAGIC)) != 0) or
+        (header.version != CORPUS_VERSION) or ((size_t)info.st_size != expected)) {
+        cerr << argv[2] << " is not a version " << CORPUS_VERSION << " corpus or is cut short" << endl;
+        munmap(mapped, info.st_size);
+        return 1;
+    }
+
+    /* check the boards on every core */
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    runThreads(0, header.boards, checkBoards, &job);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << header.boards << " boards (" << header.rows << "x" << header.cols << ", "
+         << header.mines << " mines): " << job.failed << " invalid";
+    if (job.checkSolvable) {
+        cout << ", " << job.unsolvable << " need a guess";
+    }
+    cout << " in " << fixed << setprecision(2) << elapsed.count() << " s, "
+         << setprecision(0) << header.boards / elapsed.count() << " boards/s" << endl;
+    munmap(mapped, info.st_size);
+    return (job.failed == 0) and (job.unsolvable == 0) ? 0 : 1;
+}
+
+/*
+ * main
+ * purpose: Run the generate or verify command
+ * parameters: See usage above
+ * returns: 0 if the command succeeded, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    string command = (argc > 1) ? argv[1] : "";
+    if (command == "generate") {
+        return generate(argc, argv);
+    } else if (command == "verify") {
+        return verify(argc, argv);
+    }
+    cerr << "usage: ./boardcorpus generate <file> <boards> <rows> <cols> <mines> [seed]" << endl
+         << "       ./boardcorpus verify <file> [solvable]" << endl;
+    return 1;
+}
@@ -0,0 +1,144 @@
+/*
+ * Project: minesweeper
+ * Name: BoardShots.cpp
+ * Author: Tygan Chin
+ * Purpose: Plays seeded Bot games and saves a picture of the game after every
+ *          move, drawn by the game itself into a render texture instead of a
+ *          window, for checking the drawing against earlier pictures and for
+ *          documentation. Frames are drawn on this thread (it owns the OpenGL
+ *          context) and written to PNG files on every core while the next
+ *          frames are drawn. The clock in each frame shows the move number,
+ *          so the same seed always gives the same pictures.
+ * Usage: ./boardshots <directory> <games> <easy|medium|hard> [seed] [threads]
+ * Note: Drawing needs an OpenGL context. On machines without a display run it
+ *       under a virtual one (e.g. "xvfb-run ./boardshots shots 10 easy").
+ */
+
+#include "../Files_h/Minesweeper.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Bot.h"
+#include "../Files_h/WorkerPool.h"
+#include "../Files_h/Game_Constants.h"
+#include "SFML/Graphics.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+
+using namespace std;
+using namespace sf;
+
+/* frames drawn per saving thread before waiting for the files to be written
+   (keeps the frames waiting to be saved from filling memory) */
+static const unsigned FRAMES_PER_THREAD = 8;
+
+/*
+ * frameName
+ * purpose: Make the file name of a frame
+ * parameters:
+ *      const string &directory : Where the frames are saved
+ *       const string &diffName : The difficulty's name
+ *                    long game : The game's number
+ *                    int frame : The frame's number in the game (0 is the
+ *                                board before the first move)
+ * returns: The path of the frame's PNG file
+ */
+string frameName(const string &directory, const string &diffName, long game, int frame)
+{
+    ostringstream name;
+    name << directory << "/" << diffName << "_" << setfill('0') << setw(6)
+         << game << "_" << setw(4) << frame << ".png";
+    return name.str();
+}
+
+/*
+ * main
+ * purpose: Play the games, draw every move and save the frames
+ * parameters: See usage above
+ * returns: 0 if every frame was saved, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    int diff = (argc > 3) ? find(DIFF_NAMES, DIFF_NAMES + NUM_DIFFS, string(argv[3])) - DIFF_NAMES : NUM_DIFFS;
+    if (diff == NUM_DIFFS) {
+        cerr << "usage: ./boardshots <directory> <games> <easy|medium|hard> [seed] [threads]" << endl;
+        return 1;
+    }
+    string directory = argv[1];
+    long games = max(1L, atol(argv[2]));
+    unsigned seed = (argc > 4) ? atoi(argv[4]) : 1;
+    unsigned threads = (argc > 5) ? atoi(argv[5]) : 0;
+    filesystem::create_directories(directory);
+
+    /* the game's drawing, pointed at a texture the size of its window */
+    Minesweeper drawer(diff);
+    RenderTexture frame;
+    Vector2u size = drawer.frameSize();
+    if (not frame.create(size.x, size.y)) {
+        cerr << "could not create a " << size.x << "x" << size.y << " render texture" << endl;
+        return 1;
+    }
+
+    /* the threads that write the files */
+    WorkerPool savers;
+    savers.start(threads);
+    long batch = FRAMES_PER_THREAD * max(1u, savers.size());
+    atomic<long> failed(0);
+    long frames = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Bot bot;
+    for (long game = 0; game < games; ++game) {
+
+        /* play the game, then replay its moves on the same mines */
+        Board played;
+        played.setSeed(seed + game);
+        played.setBoard(DIFF_COLS[diff], DIFF_ROWS[diff], DIFF_BOMBS[diff]);
+        bot.play(played);
+        vector<Pos> moves = played.getMoves();
+        vector<Pos> mines = played.getMines();
+        Board replay;
+        replay.setBoard(DIFF_COLS[diff], DIFF_ROWS[diff], mines.size());
+        replay.setLayout(mines);
+
+        for (size_t move = 0; move <= moves.size(); ++move) {
+            if (move > 0) {
+                replay.move(moves[move - 1].first, moves[move - 1].second);
+            }
+
+            /* draw the frame here and copy it out of the texture */
+            drawer.drawBoard(frame, replay, seconds(move));
+            frame.display();
+            shared_ptr<Image> image = make_shared<Image>(frame.getTexture().copyToImage());
+
+            /* write it on a saving thread */
+            string name = frameName(directory, DIFF_NAMES[diff], game, move);
+            savers.submit([image, name, &failed]() {
+                if (not image->saveToFile(name)) {
+                    ++failed;
+                }
+            });
+            if (++frames % batch == 0) {
+                savers.wait();
+            }
+        }
+    }
+    savers.wait();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << frames << " frames of " << games << " " << DIFF_NAMES[diff] << " games in "
+         << fixed << setprecision(2) << elapsed.count() << "s (" << setprecision(0)
+         << frames / elapsed.count() << " frames/s, " << max(1u, savers.size())
+         << " saving threads)" << endl;
+    if (failed > 0) {
+        cerr << failed << " frames could not be saved" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * Project: minesweeper
+ * Name: FirstClick.cpp
+ * Author: Tygan Chin
+ * Purpose: Builds the first click table (see FirstClickTable.h). Plays games
+ *          with the Bot from every first click of every difficulty on all
+ *          cores and saves how many were won and how many cells the first
+ *          click opened. The board is symmetric, so only the top left quarter
+ *          of the cells is played and its totals are mirrored to the rest.
+ *          Game i of a cell is always dealt from the same seed, so a run of
+ *          games 0 to 999 and one of games 1000 to 1999 can be merged into
+ *          the same table as a single run of 2000.
+ * Usage: ./firstclick [games per cell] [first game] [output]
+ *        ./firstclick merge <output> <table> <table> ...
+ */
+
+#include "../Files_h/FirstClickTable.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Bot.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/* defaults */
+static const long DEFAULT_GAMES = 200;
+static const string DEFAULT_TABLE = FIRST_CLICK_TABLE;
+
+/* games of one cell a worker plays before taking more work */
+static const long BLOCK = 20;
+
+/* a cell of the top left quarter of a difficulty's board */
+struct workCell {
+    int diff;
+    int row;
+    int col;
+};
+
+/* state shared by the workers (the totals are kept per worker) */
+struct clickShared {
+    vector<workCell> work;
+    long games;
+    long firstGame;
+    long blocksPerCell;
+    atomic<long> nextBlock;
+};
+
+/*
+ * gameSeed
+ * purpose: Find the seed of a game from its difficulty, first click, and
+ *          index, so that every game can be dealt on its own
+ * parameters:
+ *      const workCell &cell : The difficulty and first click
+ *                long index : The index of the game
+ * returns: The seed
+ */
+unsigned gameSeed(const workCell &cell, long index)
+{
+    uint64_t z = ((uint64_t)cell.diff << 56) ^ ((uint64_t)cell.row << 48) ^
+                 ((uint64_t)cell.col << 40) ^ (uint64_t)index;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (unsigned)(z ^ (z >> 31));
+}
+
+/*
+ * work
+ * purpose: Play blocks of games until every cell has all its games
+ * parameters:
+ *           clickShared *shared : The work to do
+ *      vector<firstClickStats> *totals : This worker's totals (one per work
+ *                                        cell)
+ * returns: n/a
+ * note: Runs on a worker thread. Only this worker writes its totals, so they
+ *       are added together after the workers finish without any locks.
+ */
+void work(clickShared *shared, vector<firstClickStats> *totals)
+{
+    Bot bot;
+    vector<int> cells;
+    long numBlocks = shared->work.size() * shared->blocksPerCell;
+    for (long block = shared->nextBlock++; block < numBlocks; block = shared->nextBlock++) {
+        int index = block / shared->blocksPerCell;
+        const workCell &cell = shared->work[index];
+        int rows = DIFF_ROWS[cell.diff], cols = DIFF_COLS[cell.diff];
+        long first = (block % shared->blocksPerCell) * BLOCK;
+        long last = min(first + BLOCK, shared->games);
+
+        for (long game = first; game < last; ++game) {
+            Board board;
+            board.setSeed(gameSeed(cell, shared->firstGame + game));
+            board.setBoard(cols, rows, DIFF_BOMBS[cell.diff]);
+            board.move(cell.row, cell.col);
+            board.getVisible(cells);
+            (*totals)[index].opened += cells.size() - count(cells.begin(), cells.end(), HIDDEN);
+            (*totals)[index].wins += bot.play(board);
+            ++(*totals)[index].games;
+        }
+    }
+}
+
+/*
+ * merge
+ * purpose: Add tables together
+ * parameters: See usage above
+ * returns: 0 if every table was read and the output was written, 1 otherwise
+ */
+int merge(int argc, char *argv[])
+{
+    FirstClickTable table;
+    for (int i = 3; i < argc; ++i) {
+        if (not table.load(argv[i])) {
+            cerr << "could not read " << argv[i] << endl;
+            return 1;
+        }
+    }
+    if ((argc < 3) or (not table.save(argv[2]))) {
+        cerr << "usage: ./firstclick merge <output> <table> <table> ..." << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * main
+ * purpose: Play the games, save the table, and print each difficulty's best
+ *          and worst first clicks
+ * parameters: See usage above
+ * returns: 0 if the table was saved, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    if ((argc > 1) and (string(argv[1]) == "merge")) {
+        return merge(argc, argv);
+    }
+
+    clickShared shared;
+    shared.games = (argc > 1) ? max(1L, atol(argv[1])) : DEFAULT_GAMES;
+    shared.firstGame = (argc > 2) ? atol(argv[2]) : 0;
+    string output = (argc > 3) ? argv[3] : DEFAULT_TABLE;
+    shared.blocksPerCell = (shared.games + BLOCK - 1) / BLOCK;
+    shared.nextBlock = 0;
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        for (int row = 0; row < (DIFF_ROWS[diff] + 1) / 2; ++row) {
+            for (int col = 0; col < (DIFF_COLS[diff] + 1) / 2; ++col) {
+                workCell cell = {diff, row, col};
+                shared.work.push_back(cell);
+            }
+        }
+    }
+
+    /* play the games with a set of totals per worker */
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    cout << shared.games << " games per cell from game " << shared.firstGame
+         << ", " << shared.work.size() << " cells, " << threads << " threads" << endl;
+    firstClickStats empty = {0, 0, 0};
+    vector<vector<firstClickStats> > totals(threads, vector<firstClickStats>(shared.work.size(), empty));
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.push_back(thread(work, &shared, &totals[i]));
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers[i].join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    /* add up the workers and mirror each cell to the other quarters */
+    FirstClickTable table;
+    for (size_t i = 0; i < shared.work.size(); ++i) {
+        workCell &cell = shared.work[i];
+        firstClickStats sum = empty;
+        for (unsigned j = 0; j < threads; ++j) {
+            sum.games += totals[j][i].games;
+            sum.wins += totals[j][i].wins;
+            sum.opened += totals[j][i].opened;
+        }
+        int mirrorRow = DIFF_ROWS[cell.diff] - 1 - cell.row;
+        int mirrorCol = DIFF_COLS[cell.diff] - 1 - cell.col;
+        table.add(cell.diff, cell.row, cell.col, sum);
+        if (mirrorRow != cell.row) {
+            table.add(cell.diff, mirrorRow, cell.col, sum);
+        }
+        if (mirrorCol != cell.col) {
+            table.add(cell.diff, cell.row, mirrorCol, sum);
+        }
+        if ((mirrorRow != cell.row) and (mirrorCol != cell.col)) {
+            table.add(cell.diff, mirrorRow, mirrorCol, sum);
+        }
+    }
+
+    /* print the best and worst first clicks */
+    cout << fixed << setprecision(1) << elapsed.count() << " s" << endl;
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        Pos best = table.bestCell(diff), worst = best;
+        for (int row = 0; row < DIFF_ROWS[diff]; ++row) {
+            for (int col = 0; col < DIFF_COLS[diff]; ++col) {
+                if (table.winRate(diff, row, col) < table.winRate(diff, worst.first, worst.second)) {
+                    worst = make_pair(row, col);
+                }
+            }
+        }
+        cout << left << setw(8) << DIFF_NAMES[diff] << right << "best (" << best.first 
+             << "," << best.second << ") " << 100 * table.winRate(diff, best.first, best.second)
+             << "% opening " << table.openingSize(diff, best.first, best.second)
+             << "   worst (" << worst.first << "," << worst.second << ") " 
+             << 100 * table.winRate(diff, worst.first, worst.second) << "% opening " 
+             << table.openingSize(diff, worst.first, worst.second) << endl;
+    }
+
+    if (not table.save(output)) {
+        cerr << "could not write " << output << endl;
+        return 1;
+    }
+    cout << "saved " << output << endl;
+    return 0;
+}
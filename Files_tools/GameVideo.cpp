@@ -0,0 +1,266 @@
+/*
+ * Project: minesweeper
+ * Name: GameVideo.cpp
+ * Author: Tygan Chin
+ * Purpose: Turns a recorded game (History/lastGame.txt is saved after every
+ *          game) into video frames at a chosen frame rate, drawn off screen
+ *          by the game itself. A frame only changes when a click is made or
+ *          the clock ticks, so each run of identical frames is drawn once and
+ *          encoded once, on every core, while the next ones are drawn. The
+ *          frames are written as numbered PNG or PPM files, or as one stream
+ *          of PPM frames on stdout (in order) to pipe into a video encoder:
+ *          ./gamevideo History/lastGame.txt - 30 |
+ *              ffmpeg -f image2pipe -framerate 30 -i - game.mp4
+ * Usage: ./gamevideo <record> <directory|-> [fps] [png|ppm] [threads]
+ * Note: Drawing needs an OpenGL context. On machines without a display run it
+ *       under a virtual one (e.g. with xvfb-run).
+ */
+
+#include "../Files_h/Minesweeper.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/GameRecord.h"
+#include "../Files_h/WorkerPool.h"
+#include "../Files_h/Game_Constants.h"
+#include "SFML/Graphics.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+
+using namespace std;
+using namespace sf;
+
+/* defaults, and how long the last frame is held after the game ends */
+static const int DEFAULT_FPS = 30;
+static const long END_HOLD = 2000;
+
+/* runs of frames drawn per encoding thread before writing them out (keeps
+   the frames waiting to be encoded from filling memory) */
+static const unsigned RUNS_PER_THREAD = 4;
+
+/* identical frames in a row: the first frame, how many there are, how many
+   clicks they show and the second on the clock */
+struct frameRun {
+    long first;
+    long frames;
+    size_t moves;
+    long second;
+};
+
+/*
+ * findRuns
+ * purpose: Split the video into runs of identical frames
+ * parameters:
+ *      GameRecord &record : The game
+ *                 int fps : Frames per second
+ * returns: The runs, in order
+ * note: Frame i shows the game at i / fps seconds, and the video lasts until
+ *       END_HOLD after the game ended
+ */
+vector<frameRun> findRuns(GameRecord &record, int fps)
+{
+    const vector<recordedMove> &moves = record.getMoves();
+    long last = max(record.getLength(), moves.empty() ? 0 : moves.back().time) + END_HOLD;
+    long frames = ((last * fps) / 1000) + 1;
+
+    vector<frameRun> runs;
+    size_t made = 0;
+    for (long frame = 0; frame < frames; ++frame) {
+        long time = (frame * 1000) / fps;
+        while ((made < moves.size()) and (moves[made].time <= time)) {
+            ++made;
+        }
+        if ((runs.empty()) or (runs.back().moves != made) or (runs.back().second != time / 1000)) {
+            frameRun run = {frame, 0, made, time / 1000};
+            runs.push_back(run);
+        }
+        ++runs.back().frames;
+    }
+    return runs;
+}
+
+/*
+ * encodePPM
+ * purpose: Encode an image as a binary PPM
+ * parameters:
+ *      const Image &image : The image
+ * returns: The PPM file's bytes (the image's alpha is dropped)
+ */
+string encodePPM(const Image &image)
+{
+    Vector2u size = image.getSize();
+    string header = "P6\n" + to_string(size.x) + " " + to_string(size.y) + "\n255\n";
+    size_t pixels = (size_t)size.x * size.y;
+    string bytes(header.size() + (pixels * 3), '\0');
+    copy(header.begin(), header.end(), bytes.begin());
+
+    const Uint8 *rgba = image.getPixelsPtr();
+    char *rgb = &bytes[header.size()];
+    for (size_t i = 0; i < pixels; ++i) {
+        rgb[(i * 3)]     = rgba[(i * 4)];
+        rgb[(i * 3) + 1] = rgba[(i * 4) + 1];
+        rgb[(i * 3) + 2] = rgba[(i * 4) + 2];
+    }
+    return bytes;
+}
+
+/*
+ * frameName
+ * purpose: Make the file name of a frame
+ * parameters:
+ *      const string &directory : Where the frames are saved
+ *                   long frame : The frame's number
+ *         const string &format : The file extension (png or ppm)
+ * returns: The path of the frame's file
+ */
+string frameName(const string &directory, long frame, const string &format)
+{
+    ostringstream name;
+    name << directory << "/frame_" << setfill('0') << setw(6) << frame << "." << format;
+    return name.str();
+}
+
+/*
+ * saveRun
+ * purpose: Encode a run's frame once and write it to each of the run's files
+ * parameters:
+ *           const Image &image : The run's frame
+ *          const frameRun &run : The run
+ *      const string &directory : Where the frames are saved
+ *         const string &format : png or ppm
+ * returns: The number of files that couldn't be written
+ * note: Runs on an encoding thread
+ */
+long saveRun(const Image &image, const frameRun &run, const string &directory, const string &format)
+{
+    long failed = 0;
+    string first = frameName(directory, run.first, format);
+    if (format == "png") {
+        if (not image.saveToFile(first)) {
+            return run.frames;
+        }
+    } else {
+        string bytes = encodePPM(image);
+        ofstream output(first, ios::binary);
+        if (not output.write(bytes.data(), bytes.size())) {
+            return run.frames;
+        }
+    }
+
+    /* the rest of the run are copies of the first file */
+    for (long frame = run.first + 1; frame < run.first + run.frames; ++frame) {
+        error_code error;
+        filesystem::copy_file(first, frameName(directory, frame, format),
+                              filesystem::copy_options::overwrite_existing, error);
+        failed += (error) ? 1 : 0;
+    }
+    return failed;
+}
+
+/*
+ * main
+ * purpose: Draw the recorded game's frames and write them
+ * parameters: See usage above
+ * returns: 0 if every frame was written, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    GameRecord record;
+    if ((argc < 3) or (not record.load(argv[1]))) {
+        cerr << "usage: ./gamevideo <record> <directory|-> [fps] [png|ppm] [threads]" << endl;
+        return 1;
+    }
+    string directory = argv[2];
+    int fps = (argc > 3) ? max(1, atoi(argv[3])) : DEFAULT_FPS;
+    string format = (argc > 4) ? argv[4] : "png";
+    unsigned threads = (argc > 5) ? atoi(argv[5]) : 0;
+    bool toStream = (directory == "-");
+    if (toStream) {
+        format = "ppm";
+    } else if ((format != "png") and (format != "ppm")) {
+        cerr << "the format must be png or ppm" << endl;
+        return 1;
+    } else {
+        filesystem::create_directories(directory);
+    }
+    ostream &report = toStream ? cerr : cout;
+
+    /* the game's drawing, pointed at a texture the size of its window */
+    Minesweeper drawer(record.getDifficulty());
+    RenderTexture frame;
+    Vector2u size = drawer.frameSize();
+    if (not frame.create(size.x, size.y)) {
+        cerr << "could not create a " << size.x << "x" << size.y << " render texture" << endl;
+        return 1;
+    }
+
+    /* the threads that encode the frames */
+    WorkerPool encoders;
+    encoders.start(threads);
+    size_t batch = RUNS_PER_THREAD * max(1u, encoders.size());
+    vector<string> encoded(batch);
+    atomic<long> failed(0);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<frameRun> runs = findRuns(record, fps);
+    const vector<recordedMove> &moves = record.getMoves();
+    Board replay;
+    record.deal(replay);
+    size_t made = 0;
+    for (size_t first = 0; first < runs.size(); first += batch) {
+        size_t last = min(first + batch, runs.size());
+        for (size_t i = first; i < last; ++i) {
+            const frameRun &run = runs[i];
+            while (made < run.moves) {
+                record.play(replay, moves[made++]);
+            }
+
+            /* draw the run's frame here and copy it out of the texture */
+            drawer.drawBoard(frame, replay, seconds(run.second));
+            frame.display();
+            shared_ptr<Image> image = make_shared<Image>(frame.getTexture().copyToImage());
+
+            /* encode it on an encoding thread */
+            if (toStream) {
+                string *bytes = &encoded[i - first];
+                encoders.submit([image, bytes]() { *bytes = encodePPM(*image); });
+            } else {
+                encoders.submit([image, run, &directory, &format, &failed]() {
+                    failed += saveRun(*image, run, directory, format);
+                });
+            }
+        }
+        encoders.wait();
+
+        /* write the batch to the stream in order */
+        for (size_t i = first; (toStream) and (i < last); ++i) {
+            for (long copy = 0; copy < runs[i].frames; ++copy) {
+                cout.write(encoded[i - first].data(), encoded[i - first].size());
+            }
+        }
+    }
+    cout.flush();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    long frames = runs.back().first + runs.back().frames;
+    report << frames << " frames (" << runs.size() << " drawn) of a "
+           << fixed << setprecision(1) << record.getLength() / 1000.0 << "s "
+           << DIFF_NAMES[record.getDifficulty()] << " game at " << fps << " fps in "
+           << setprecision(2) << elapsed.count() << "s (" << max(1u, encoders.size())
+           << " encoding threads)" << endl;
+    if (not cout) {
+        cerr << "the stream could not be written" << endl;
+        return 1;
+    } else if (failed > 0) {
+        cerr << failed << " frames could not be written" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Project: minesweeper
+ * Name: GeneratorBench.cpp
+ * Author: Tygan Chin
+ * Purpose: Benchmarks the no guessing Generator. Generates boards for each
+ *          difficulty from a first move in the middle of the board and
+ *          reports the latency of each board, the rate boards are tried at,
+ *          and how many are rejected.
+ * Usage: ./generatorbench [boards per difficulty] [seed]
+ */
+
+#include "../Files_h/Generator.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+/* default number of boards to generate per difficulty */
+static const int DEFAULT_BOARDS = 20;
+
+/*
+ * main
+ * purpose: Generate boards for each difficulty and print the statistics
+ * parameters: See usage above
+ * returns: 0 if every board was found, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    int boards = (argc > 1) ? max(1, atoi(argv[1])) : DEFAULT_BOARDS;
+    unsigned seed = (argc > 2) ? atoi(argv[2]) : 1;
+    cout << boards << " boards per difficulty, " << thread::hardware_concurrency()
+         << " threads" << endl;
+    cout << left << setw(8) << "diff" << right << setw(8) << "found" << setw(12)
+         << "tried/s" << setw(12) << "rejected" << setw(10) << "p50 ms"
+         << setw(10) << "p90 ms" << setw(10) << "max ms" << endl;
+
+    bool allFound = true;
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff];
+        Pos first = make_pair(rows / 2, cols / 2);
+
+        /* generate the boards */
+        int found = 0;
+        long tried = 0, rejected = 0;
+        double seconds = 0;
+        vector<double> latencies;
+        for (int i = 0; i < boards; ++i) {
+            Generator generator;
+            found += not generator.generate(rows, cols, DIFF_BOMBS[diff], first, seed++).empty();
+            generatorStats stats = generator.getStats();
+            tried += stats.boardsTried;
+            rejected += stats.boardsRejected;
+            seconds += stats.seconds;
+            latencies.push_back(stats.seconds * 1000);
+        }
+        allFound = allFound and (found == boards);
+
+        /* print the statistics */
+        sort(latencies.begin(), latencies.end());
+        cout << left << setw(8) << DIFF_NAMES[diff] << right << fixed << setprecision(1)
+             << setw(8) << found << setw(12) << tried / seconds
+             << setw(11) << 100.0 * rejected / max(1L, tried) << "%"
+             << setw(10) << latencies[latencies.size() / 2]
+             << setw(10) << latencies[latencies.size() * 9 / 10]
+             << setw(10) << latencies.back() << endl;
+    }
+    return allFound ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/*
+ * Project: minesweeper
+ * Name: LaneBench.cpp
+ * Author: Tygan Chin
+ * Purpose: Compares the games played per second on one core by LaneSim and by
+ *          a loop over Board::move playing the same strategy (the moves 
+ *          Solver::solveSimple proves are safe, otherwise a random unknown
+ *          cell). The win rates should agree, which checks LaneSim's rules.
+ * Usage: ./lanebench [games per difficulty] [seed]
+ */
+
+#include "../Files_h/LaneSim.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Solver.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+/* default number of games per difficulty */
+static const long DEFAULT_GAMES = 200000;
+
+/*
+ * playScalar
+ * purpose: Play games one at a time with Board::move
+ * parameters:
+ *         int diff : The difficulty to play
+ *       long games : Number of games to play
+ *      unsigned seed : Seed of the run
+ * returns: The number of games played, won, and the guesses made
+ */
+laneResults playScalar(int diff, long games, unsigned seed)
+{
+    int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff], mines = DIFF_BOMBS[diff];
+    laneResults results = {0, 0, 0};
+    Solver solver;
+    mt19937 gen(seed);
+    vector<int> cells;
+    for (long i = 0; i < games; ++i) {
+        Board board;
+        board.setSeed(seed + i);
+        board.setBoard(cols, rows, mines);
+        int outcome = board.move(rows / 2, cols / 2);
+        while ((outcome != MINE_HIT) and (not board.won())) {
+            board.getVisible(cells);
+            solver.solveSimple(cells, rows, cols, mines);
+            vector<Pos> moves = solver.safeCells();
+
+            /* guess a random cell that isn't a known mine */
+            if (moves.empty()) {
+                vector<Pos> unknown;
+                for (int row = 0; row < rows; ++row) {
+                    for (int col = 0; col < cols; ++col) {
+                        if ((not board.isShown(row, col)) and (not solver.isMine(row, col))) {
+                            unknown.push_back(make_pair(row, col));
+                        }
+                    }
+                }
+                uniform_int_distribution<> dis(0, unknown.size() - 1);
+                moves.push_back(unknown[dis(gen)]);
+                ++results.guesses;
+            }
+            for (size_t j = 0; (j < moves.size()) and (outcome != MINE_HIT); ++j) {
+                outcome = board.move(moves[j].first, moves[j].second);
+            }
+        }
+        ++results.games;
+        results.wins += (outcome != MINE_HIT);
+    }
+    return results;
+}
+
+/*
+ * report
+ * purpose: Print one engine's results
+ * parameters:
+ *       const string &name : Name of the engine
+ *      laneResults results : Its results
+ *           double seconds : Time it took
+ * returns: n/a
+ */
+void report(const string &name, laneResults results, double seconds)
+{
+    cout << left << setw(8) << name << right << fixed << setprecision(0)
+         << setw(12) << results.games / seconds << setprecision(2)
+         << setw(9) << 100.0 * results.wins / results.games
+         << setw(14) << (double)results.guesses / results.games << endl;
+}
+
+/*
+ * main
+ * purpose: Run both engines on each difficulty that fits in a plane
+ * parameters: See usage above
+ * returns: 0
+ */
+int main(int argc, char *argv[])
+{
+    long games = (argc > 1) ? max(1L, atol(argv[1])) : DEFAULT_GAMES;
+    unsigned seed = (argc > 2) ? atoi(argv[2]) : 1;
+    cout << games << " games per difficulty, " << SIM_LANES << " lanes, 1 thread" << endl;
+
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        if (DIFF_ROWS[diff] * DIFF_COLS[diff] > PLANE_BITS) {
+            cout << DIFF_NAMES[diff] << ": more than " << PLANE_BITS 
+                 << " cells, scalar only (see simulate)" << endl;
+            continue;
+        }
+        cout << DIFF_NAMES[diff] << endl << left << setw(8) << "engine" << right
+             << setw(12) << "games/s" << setw(9) << "win %" << setw(14)
+             << "guesses/game" << endl;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        laneResults scalar = playScalar(diff, games, seed);
+        chrono::duration<double> scalarTime = chrono::steady_clock::now() - start;
+        report("scalar", scalar, scalarTime.count());
+
+        start = chrono::steady_clock::now();
+        LaneSim sim(DIFF_ROWS[diff], DIFF_COLS[diff], DIFF_BOMBS[diff]);
+        laneResults lanes = sim.run(0, games, seed);
+        chrono::duration<double> laneTime = chrono::steady_clock::now() - start;
+        report("lanes", lanes, laneTime.count());
+
+        cout << "speedup " << setprecision(1) << scalarTime.count() / laneTime.count() << "x" << endl;
+    }
+    return 0;
+}
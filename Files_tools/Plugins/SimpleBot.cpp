@@ -0,0 +1,159 @@
+/*
+ * Project: minesweeper
+ * Name: SimpleBot.cpp
+ * Author: Tygan Chin
+ * Purpose: An example bot library for the tournament tool (see BotPlugin.h).
+ *          Marks the mines that follow directly from each number, clicks the
+ *          cells that are then certain to be safe, and otherwise clicks a
+ *          random hidden cell that isn't a known mine. It uses nothing from
+ *          the game so it can be built on its own.
+ * Build: make simplebot.so
+ */
+
+#include "../../Files_h/BotPlugin.h"
+#include <vector>
+#include <random>
+
+using namespace std;
+
+/* a bot's state: its random numbers and the cells it knows are mines */
+struct simpleBot {
+    mt19937 gen;
+    vector<bool> mine;
+};
+
+/*
+ * neighbors
+ * purpose: Find the cells next to a cell
+ * parameters:
+ *      const botView *view : The board
+ *                 int cell : The cell (row major)
+ *            int *adjacent : Filled with the neighbors (room for 8)
+ * returns: The number of neighbors
+ */
+static int neighbors(const botView *view, int cell, int *adjacent)
+{
+    int row = cell / view->cols, col = cell % view->cols, count = 0;
+    for (int r = row - 1; r <= row + 1; ++r) {
+        for (int c = col - 1; c <= col + 1; ++c) {
+            bool inBounds = (r >= 0) and (r < view->rows) and (c >= 0) and (c < view->cols);
+            if (inBounds and ((r != row) or (c != col))) {
+                adjacent[count++] = (r * view->cols) + c;
+            }
+        }
+    }
+    return count;
+}
+
+/*
+ * create
+ * purpose: Make a bot
+ * parameters:
+ *      unsigned seed : Seed of the bot's guesses
+ * returns: The bot's state
+ */
+static void *create(unsigned seed)
+{
+    simpleBot *bot = new simpleBot;
+    bot->gen.seed(seed);
+    return bot;
+}
+
+/*
+ * destroy
+ * purpose: Free a bot
+ * parameters:
+ *      void *state : The bot's state
+ * returns: n/a
+ */
+static void destroy(void *state)
+{
+    delete static_cast<simpleBot *>(state);
+}
+
+/*
+ * choose
+ * purpose: Choose the cells to click (see BotPlugin.h)
+ * parameters:
+ *               void *state : The bot's state
+ *       const botView *view : The visible board
+ *            botMove *moves : Filled with the clicks
+ *              int maxMoves : Room in moves
+ * returns: The number of clicks
+ */
+static int choose(void *state, const botView *view, botMove *moves, int maxMoves)
+{
+    simpleBot *bot = static_cast<simpleBot *>(state);
+    int size = view->rows * view->cols, adjacent[8], count = 0;
+    bot->mine.assign(size, false);
+
+    /* mark mines until nothing changes */
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int cell = 0; cell < size; ++cell) {
+            if (view->cells[cell] <= 0) {
+                continue;
+            }
+            int n = neighbors(view, cell, adjacent), hidden = 0;
+            for (int i = 0; i < n; ++i) {
+                hidden += (view->cells[adjacent[i]] == BOT_HIDDEN);
+            }
+            for (int i = 0; (i < n) and (hidden == view->cells[cell]); ++i) {
+                if ((view->cells[adjacent[i]] == BOT_HIDDEN) and (not bot->mine[adjacent[i]])) {
+                    bot->mine[adjacent[i]] = changed = true;
+                }
+            }
+        }
+    }
+
+    /* click the hidden neighbors of numbers whose mines are all marked */
+    for (int cell = 0; (cell < size) and (count < maxMoves); ++cell) {
+        if (view->cells[cell] < 0) {
+            continue;
+        }
+        int n = neighbors(view, cell, adjacent), marked = 0;
+        for (int i = 0; i < n; ++i) {
+            marked += bot->mine[adjacent[i]];
+        }
+        for (int i = 0; (i < n) and (marked == view->cells[cell]) and (count < maxMoves); ++i) {
+            if ((view->cells[adjacent[i]] == BOT_HIDDEN) and (not bot->mine[adjacent[i]])) {
+                moves[count].row = adjacent[i] / view->cols;
+                moves[count].col = adjacent[i] % view->cols;
+                ++count;
+            }
+        }
+    }
+
+    /* otherwise guess a hidden cell that isn't a known mine */
+    if (count == 0) {
+        vector<int> unknown;
+        for (int cell = 0; cell < size; ++cell) {
+            if ((view->cells[cell] == BOT_HIDDEN) and (not bot->mine[cell])) {
+                unknown.push_back(cell);
+            }
+        }
+        if (unknown.empty() or (maxMoves < 1)) {
+            return 0;
+        }
+        int cell = unknown[uniform_int_distribution<>(0, unknown.size() - 1)(bot->gen)];
+        moves[0].row = cell / view->cols;
+        moves[0].col = cell % view->cols;
+        count = 1;
+    }
+    return count;
+}
+
+/* the bot's functions */
+static const botPlugin SIMPLE_BOT = {BOT_PLUGIN_VERSION, "simple", create, destroy, choose};
+
+/*
+ * minesweeperBot
+ * purpose: The function the tournament tool looks up (BOT_PLUGIN_ENTRY)
+ * parameters: n/a
+ * returns: The bot's functions
+ */
+extern "C" const botPlugin *minesweeperBot(void)
+{
+    return &SIMPLE_BOT;
+}
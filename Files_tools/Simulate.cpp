@@ -0,0 +1,229 @@
+/*
+ * Project: minesweeper
+ * Name: Simulate.cpp
+ * Author: Tygan Chin
+ * Purpose: Plays games of each difficulty with the Bot on every core, without
+ *          a window, and reports the games played per second, the win rate
+ *          with its 95% confidence interval, and the distribution of clicks
+ *          per game. Stops a difficulty early once the win rate is known to
+ *          within the given precision.
+ * Usage: ./simulate [max games per difficulty] [precision] [threads] [seed]
+ */
+
+#include "../Files_h/Board.h"
+#include "../Files_h/Bot.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+/* defaults (the precision is the half width of the confidence interval) */
+static const long DEFAULT_GAMES = 1000000;
+static const double DEFAULT_PRECISION = 0.002;
+
+/* games a worker plays between reports, and games before stopping early */
+static const long BATCH = 200;
+static const long MIN_GAMES = 2000;
+
+/* z score of a 95% confidence interval */
+static const double Z95 = 1.96;
+
+/* the results of some games (clicks is a histogram of clicks per game) */
+struct simTotals {
+    long games;
+    long wins;
+    vector<long> clicks;
+};
+
+/* state shared by the workers of one difficulty (batches finished ahead of
+   an earlier one wait in pending until it is added) */
+struct simShared {
+    int diff;
+    long maxGames;
+    double precision;
+    unsigned seed;
+    atomic<long> nextGame;
+    atomic<bool> done;
+    mutex totalsLock;
+    simTotals totals;
+    long added;
+    map<long, simTotals> pending;
+};
+
+/*
+ * wilson
+ * purpose: Find the 95% Wilson score interval of a win rate
+ * parameters:
+ *       long wins : Number of games won
+ *      long games : Number of games played
+ *         double &low : Set to the bottom of the interval
+ *        double &high : Set to the top of the interval
+ * returns: n/a
+ */
+void wilson(long wins, long games, double &low, double &high)
+{
+    double n = games, p = (double)wins / games, z2 = Z95 * Z95;
+    double centre = (p + (z2 / (2 * n))) / (1 + (z2 / n));
+    double half = (Z95 / (1 + (z2 / n))) * sqrt((p * (1 - p) / n) + (z2 / (4 * n * n)));
+    low = centre - half;
+    high = centre + half;
+}
+
+/*
+ * percentile
+ * purpose: Find a percentile of the clicks per game
+ * parameters:
+ *      const simTotals &totals : The results to look in
+ *               double fraction : The percentile as a fraction (0.5 is the
+ *                                 median)
+ * returns: The least number of clicks at or above the percentile
+ */
+int percentile(const simTotals &totals, double fraction)
+{
+    long seen = 0, target = ceil(fraction * totals.games);
+    for (size_t clicks = 0; clicks < totals.clicks.size(); ++clicks) {
+        seen += totals.clicks[clicks];
+        if ((seen >= target) and (seen > 0)) {
+            return clicks;
+        }
+    }
+    return totals.clicks.size() - 1;
+}
+
+/*
+ * work
+ * purpose: Play batches of games and add them to the shared totals until the
+ *          games run out or the win rate is precise enough
+ * parameters:
+ *      simShared *shared : The difficulty being played and its totals
+ * returns: n/a
+ * note: Runs on a worker thread. Game i is always dealt with seed + i and
+ *       the batches are added in order, stopping after the first one that
+ *       makes the interval narrow enough, so the results don't depend on the
+ *       number of threads.
+ */
+void work(simShared *shared)
+{
+    int rows = DIFF_ROWS[shared->diff], cols = DIFF_COLS[shared->diff];
+    Bot bot;
+    simTotals batch = {0, 0, vector<long>((rows * cols) + 1, 0)};
+
+    while (not shared->done) {
+        long first = shared->nextGame.fetch_add(BATCH);
+        long last = min(first + BATCH, shared->maxGames);
+        if (first >= last) {
+            break;
+        }
+
+        /* play the batch */
+        batch.games = batch.wins = 0;
+        fill(batch.clicks.begin(), batch.clicks.end(), 0);
+        for (long game = first; game < last; ++game) {
+            Board board;
+            board.setSeed(shared->seed + game);
+            board.setBoard(cols, rows, DIFF_BOMBS[shared->diff]);
+            batch.wins += bot.play(board);
+            ++batch.clicks[board.getMoves().size()];
+            ++batch.games;
+        }
+
+        /* add the batches that are next in order to the totals, and stop
+           once the interval is narrow enough */
+        lock_guard<mutex> guard(shared->totalsLock);
+        simTotals &totals = shared->totals;
+        shared->pending[first / BATCH] = batch;
+        map<long, simTotals>::iterator next = shared->pending.find(shared->added);
+        while ((not shared->done) and (next != shared->pending.end())) {
+            totals.games += next->second.games;
+            totals.wins += next->second.wins;
+            for (size_t i = 0; i < next->second.clicks.size(); ++i) {
+                totals.clicks[i] += next->second.clicks[i];
+            }
+            shared->pending.erase(next);
+            next = shared->pending.find(++shared->added);
+
+            double low, high;
+            wilson(totals.wins, totals.games, low, high);
+            if ((totals.games >= MIN_GAMES) and ((high - low) / 2 <= shared->precision)) {
+                shared->done = true;
+            }
+        }
+    }
+}
+
+/*
+ * main
+ * purpose: Simulate each difficulty and print the statistics
+ * parameters: See usage above
+ * returns: 0
+ */
+int main(int argc, char *argv[])
+{
+    long maxGames = (argc > 1) ? max(1L, atol(argv[1])) : DEFAULT_GAMES;
+    double precision = (argc > 2) ? atof(argv[2]) : DEFAULT_PRECISION;
+    unsigned threads = (argc > 3) ? atoi(argv[3]) : thread::hardware_concurrency();
+    unsigned seed = (argc > 4) ? atoi(argv[4]) : 1;
+    threads = max(1u, threads);
+
+    cout << "up to " << maxGames << " games per difficulty, precision +/-"
+         << 100 * precision << "%, " << threads << " threads" << endl;
+    cout << left << setw(8) << "diff" << right << setw(10) << "games"
+         << setw(11) << "games/s" << setw(9) << "win %" << setw(18) << "95% CI"
+         << setw(7) << "mean" << setw(5) << "p50" << setw(5) << "p90"
+         << setw(5) << "p99" << setw(5) << "max" << "  (clicks)" << endl;
+
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        simShared shared;
+        shared.diff = diff;
+        shared.maxGames = maxGames;
+        shared.precision = precision;
+        shared.seed = seed;
+        shared.nextGame = 0;
+        shared.done = false;
+        shared.added = 0;
+        shared.totals.games = shared.totals.wins = 0;
+        shared.totals.clicks.assign((DIFF_ROWS[diff] * DIFF_COLS[diff]) + 1, 0);
+
+        /* play the games on every thread */
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.push_back(thread(work, &shared));
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            workers[i].join();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        /* print the statistics */
+        simTotals &totals = shared.totals;
+        double low, high, clickSum = 0;
+        wilson(totals.wins, totals.games, low, high);
+        for (size_t i = 0; i < totals.clicks.size(); ++i) {
+            clickSum += (double)i * totals.clicks[i];
+        }
+        int most = totals.clicks.size() - 1;
+        while ((most > 0) and (totals.clicks[most] == 0)) {
+            --most;
+        }
+        cout << left << setw(8) << DIFF_NAMES[diff] << right << fixed
+             << setw(10) << totals.games << setprecision(0)
+             << setw(11) << totals.games / elapsed.count() << setprecision(2)
+             << setw(9) << 100.0 * totals.wins / totals.games
+             << setw(9) << 100 * low << " - " << setw(6) << 100 * high
+             << setprecision(1) << setw(7) << clickSum / totals.games
+             << setw(5) << percentile(totals, 0.5) << setw(5) << percentile(totals, 0.9)
+             << setw(5) << percentile(totals, 0.99) << setw(5) << most << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,719 @@
+/*
+ * Project: minesweeper
+ * Name: SolverBench.cpp
+ * Author: Tygan Chin
+ * Purpose: Benchmarks the Solver on a fixed corpus of positions taken from
+ *          easy, medium and hard games, from the opening to late endgames
+ *          that need a guess. Reports the speed (positions/s), latency
+ *          percentiles, and whether each position's safe cells, mines and
+ *          probabilities match the corpus. The corpus's answers are found by
+ *          counting every arrangement of the mines, without the Solver.
+ * Usage: ./solverbench [corpus file] [passes]
+ *        ./solverbench generate [corpus file]
+ */
+
+#include "../Files_h/Solver.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+/* corpus file and benchmark settings */
+static const string CORPUS_FILE = "Positions/solverCorpus.txt";
+static const int DEFAULT_PASSES = 20;
+static const double TOLERANCE   = 1e-6;
+
+/* corpus generation */
+static const int POSITIONS_PER_STAGE = 6;
+static const int NUM_STAGES = 3;
+static const string STAGES[] = {"opening", "midgame", "endgame"};
+static const float MIDGAME_REVEALED = 0.5;
+static const float ENDGAME_REVEALED = 0.75;
+
+/* cell answers in the corpus */
+static const char ANS_SAFE = 'S', ANS_MINE = 'M', ANS_OPEN = '?', ANS_SHOWN = '-';
+
+/* a position and its known answers */
+struct position {
+    string name;
+    int rows, cols, mines;
+    vector<int> cells;
+    string answer;
+    vector<double> probs;
+};
+
+/* the hidden cells next to a group of numbers that share cells, and how
+   many of the group's arrangements have each count of mines (in total and
+   with each cell a mine) */
+struct frontGroup {
+    vector<int> cells;
+    vector<double> arrangements;
+    vector<vector<double>> cellMines;
+};
+
+/* a solver to benchmark (inexact solvers only need to avoid wrong answers) */
+struct solverEntry {
+    string name;
+    void (*solve)(Solver &solver, position &pos);
+    bool exact;
+};
+
+/* benchmark results of one solver on one group of positions */
+struct benchResult {
+    int positions, correct;
+    double seconds;
+    vector<double> latencies;
+};
+
+/* helper functions */
+static bool loadCorpus(string file, vector<position> &corpus);
+static bool checkPosition(Solver &solver, position &pos, bool exact);
+static bool benchmark(const solverEntry &entry, vector<position> &corpus, int passes);
+static void report(string name, string group, benchResult &result);
+static double percentile(vector<double> &sorted, double fraction);
+static void generateCorpus(string file);
+static void writePosition(ostream &out, position &pos);
+static void countAnswers(position &pos, vector<double> &mineWays, vector<double> &safeWays);
+static void enumerate(position &pos, frontGroup &group, vector<int> &need, vector<int> &open,
+                      vector<int> &mines, size_t next, int placed);
+static vector<double> combine(vector<frontGroup> &groups, int skip);
+static void solveExact(Solver &solver, position &pos);
+static void solveSimple(Solver &solver, position &pos);
+
+/* solvers to benchmark */
+static const solverEntry SOLVERS[] = {
+    {"exact", solveExact, true},
+    {"simple", solveSimple, false}
+};
+static const int NUM_SOLVERS = sizeof(SOLVERS) / sizeof(SOLVERS[0]);
+
+/*
+ * main
+ * purpose: Generate the corpus or benchmark every solver on it
+ * parameters: See usage above
+ * returns: 0 if every position was solved correctly, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    /* rebuild the corpus if asked */
+    if ((argc > 1) and (string(argv[1]) == "generate")) {
+        generateCorpus(argc > 2 ? argv[2] : CORPUS_FILE);
+        return 0;
+    }
+
+    /* load the corpus */
+    string file = (argc > 1) ? argv[1] : CORPUS_FILE;
+    int passes = (argc > 2) ? max(1, atoi(argv[2])) : DEFAULT_PASSES;
+    vector<position> corpus;
+    if (not loadCorpus(file, corpus)) {
+        cerr << "could not read corpus " << file << endl;
+        return 1;
+    }
+
+    /* time and check every solver */
+    cout << corpus.size() << " positions, " << passes << " passes" << endl;
+    cout << left << setw(10) << "solver" << setw(16) << "group" << right
+         << setw(8) << "correct" << setw(12) << "pos/s" << setw(10) << "p50 us"
+         << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(10) << "max us"
+         << endl;
+    bool allCorrect = true;
+    for (int i = 0; i < NUM_SOLVERS; ++i) {
+        allCorrect = benchmark(SOLVERS[i], corpus, passes) and allCorrect;
+    }
+    return allCorrect ? 0 : 1;
+}
+
+
+/******************************************************\
+ *                   Solver Entries                    *
+\******************************************************/
+
+/*
+ * solveExact
+ * purpose: Solve the position with the full Solver
+ * parameters:
+ *      Solver &solver : The solver
+ *      position &pos : The position to solve
+ * returns: n/a
+ */
+static void solveExact(Solver &solver, position &pos)
+{
+    solver.solve(pos.cells, pos.rows, pos.cols, pos.mines);
+}
+
+/*
+ * solveSimple
+ * purpose: Solve the position with only the Solver's direct deductions
+ * parameters:
+ *      Solver &solver : The solver
+ *      position &pos : The position to solve
+ * returns: n/a
+ */
+static void solveSimple(Solver &solver, position &pos)
+{
+    solver.solveSimple(pos.cells, pos.rows, pos.cols, pos.mines);
+}
+
+
+/******************************************************\
+ *                 Benchmark Functions                 *
+\******************************************************/
+
+/*
+ * checkPosition
+ * purpose: Compare the solver's last solve with the position's answers
+ * parameters:
+ *      Solver &solver : The solver that just solved the position
+ *      position &pos : The position
+ *          bool exact : Whether the solver should find every answer
+ * returns: True if every safe cell, mine and probability matches, or for an
+ *          inexact solver, if every safe cell and mine it found is right
+ */
+static bool checkPosition(Solver &solver, position &pos, bool exact)
+{
+    for (int i = 0; i < pos.rows * pos.cols; ++i) {
+        int row = i / pos.cols, col = i % pos.cols;
+        char ans = pos.answer[i];
+        if (ans == ANS_SHOWN) {
+            continue;
+        }
+        bool wrongSafe = solver.isSafe(row, col) and (ans != ANS_SAFE);
+        bool wrongMine = solver.isMine(row, col) and (ans != ANS_MINE);
+        if (wrongSafe or wrongMine) {
+            return false;
+        }
+        if (not exact) {
+            continue;
+        }
+        bool safeMatch = solver.isSafe(row, col) == (ans == ANS_SAFE);
+        bool mineMatch = solver.isMine(row, col) == (ans == ANS_MINE);
+        double error = fabs(solver.mineProbability(row, col) - pos.probs[i]);
+        if ((not safeMatch) or (not mineMatch) or (error > TOLERANCE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * benchmark
+ * purpose: Time a solver on every position and report the results for each
+ *          group of positions and for the whole corpus
+ * parameters:
+ *      const solverEntry &entry : The solver to benchmark
+ *      vector<position> &corpus : The positions
+ *                    int passes : Number of times to solve each position
+ * returns: True if every position was solved correctly, false otherwise
+ */
+static bool benchmark(const solverEntry &entry, vector<position> &corpus, int passes)
+{
+    /* group by the name without its index (ex: hard-endgame) */
+    vector<string> groups;
+    vector<benchResult> results;
+    benchResult total = {0, 0, 0, vector<double>()};
+
+    Solver solver;
+    for (size_t p = 0; p < corpus.size(); ++p) {
+        string group = corpus[p].name.substr(0, corpus[p].name.rfind('-'));
+        size_t g = find(groups.begin(), groups.end(), group) - groups.begin();
+        if (g == groups.size()) {
+            groups.push_back(group);
+            results.push_back(total);
+        }
+
+        /* time each pass of the position */
+        for (int i = 0; i < passes; ++i) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            entry.solve(solver, corpus[p]);
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            results[g].seconds += elapsed.count();
+            results[g].latencies.push_back(elapsed.count() * 1e6);
+        }
+        ++results[g].positions;
+        results[g].correct += checkPosition(solver, corpus[p], entry.exact);
+    }
+
+    /* report each group then the total */
+    for (size_t g = 0; g < groups.size(); ++g) {
+        total.positions += results[g].positions;
+        total.correct += results[g].correct;
+        total.seconds += results[g].seconds;
+        total.latencies.insert(total.latencies.end(), results[g].latencies.begin(), results[g].latencies.end());
+        report(entry.name, groups[g], results[g]);
+    }
+    report(entry.name, "all", total);
+    return total.correct == total.positions;
+}
+
+/*
+ * report
+ * purpose: Print one row of the benchmark table
+ * parameters:
+ *              string name : Name of the solver
+ *             string group : Name of the group of positions
+ *      benchResult &result : The results of the group
+ * returns: n/a
+ */
+static void report(string name, string group, benchResult &result)
+{
+    sort(result.latencies.begin(), result.latencies.end());
+    stringstream correct;
+    correct << result.correct << "/" << result.positions;
+
+    cout << left << setw(10) << name << setw(16) << group << right << fixed
+         << setprecision(1) << setw(8) << correct.str()
+         << setw(12) << result.latencies.size() / result.seconds
+         << setw(10) << percentile(result.latencies, 0.50)
+         << setw(10) << percentile(result.latencies, 0.90)
+         << setw(10) << percentile(result.latencies, 0.99)
+         << setw(10) << result.latencies.back() << endl;
+}
+
+/*
+ * percentile
+ * purpose: Returns the given percentile of a sorted list
+ * parameters:
+ *      vector<double> &sorted : The sorted values
+ *             double fraction : The percentile between 0 and 1
+ * returns: The value at the percentile
+ */
+static double percentile(vector<double> &sorted, double fraction)
+{
+    size_t index = min(sorted.size() - 1, (size_t)(fraction * sorted.size()));
+    return sorted[index];
+}
+
+
+/******************************************************\
+ *                   Corpus Functions                  *
+\******************************************************/
+
+/*
+ * loadCorpus
+ * purpose: Read the positions and their answers from the corpus file
+ * parameters:
+ *                 string file : The corpus file
+ *      vector<position> &corpus : Filled with the positions
+ * returns: True if the file was read, false otherwise
+ * note: Lines starting with # are comments. Each position is a POSITION line
+ *       with its name, rows, columns and mines, the board ('.' for hidden),
+ *       the answers (see ANS_*) and the probabilities of the '?' cells.
+ */
+static bool loadCorpus(string file, vector<position> &corpus)
+{
+    ifstream input(file);
+    if (not input.is_open()) {
+        return false;
+    }
+
+    string word;
+    while (input >> word) {
+
+        /* skip comments */
+        if (word[0] == '#') {
+            getline(input, word);
+            continue;
+        }
+
+        /* read the header and board */
+        position pos;
+        input >> pos.name >> pos.rows >> pos.cols >> pos.mines;
+        for (int row = 0; row < pos.rows; ++row) {
+            input >> word;
+            for (int col = 0; col < pos.cols; ++col) {
+                pos.cells.push_back(word[col] == '.' ? HIDDEN : word[col] - '0');
+            }
+        }
+
+        /* read the answers and the probabilities of the undecided cells */
+        for (int row = 0; row < pos.rows; ++row) {
+            input >> word;
+            pos.answer += word;
+        }
+        pos.probs.assign(pos.rows * pos.cols, 0);
+        for (int i = 0; i < pos.rows * pos.cols; ++i) {
+            if (pos.answer[i] == ANS_MINE) {
+                pos.probs[i] = 1;
+            } else if (pos.answer[i] == ANS_OPEN) {
+                input >> pos.probs[i];
+            }
+        }
+        if (not input) {
+            return false;
+        }
+        corpus.push_back(pos);
+    }
+    return not corpus.empty();
+}
+
+/*
+ * generateCorpus
+ * purpose: Play seeded games with the Solver and save positions from the
+ *          opening, middle and end of the games along with their answers
+ * parameters:
+ *      string file : The corpus file to write
+ * returns: n/a
+ * note: Only used to rebuild the corpus. The Solver only picks the moves
+ *       and skips positions it can't solve exactly, the answers are counted
+ *       by writePosition.
+ */
+static void generateCorpus(string file)
+{
+    ofstream out(file);
+    out << "# Solver benchmark corpus (rebuild with ./solverbench generate)" << endl;
+    out << "# POSITION name rows cols mines, board ('.' hidden), answers ('S' safe,"
+        << " 'M' mine, '?' undecided, '-' revealed), '?' probabilities" << endl;
+
+    Solver solver;
+    unsigned seed = 0;
+    for (int diff = 0; diff < NUM_DIFFS; ++diff) {
+        int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff], mines = DIFF_BOMBS[diff];
+        int safeCells = (rows * cols) - mines;
+        vector<position> stages[NUM_STAGES];
+
+        /* play games until every stage has enough positions */
+        bool full = false;
+        while (not full) {
+            Board board;
+            board.setBoard(cols, rows, mines);
+            board.setSeed(++seed);
+            int outcome = board.move(rows / 2, cols / 2);
+            bool haveMid = false;
+            position lastGuess;
+            lastGuess.rows = 0;
+
+            /* solve after each move and save positions from each stage */
+            for (int step = 0; (outcome != MINE_HIT) and (not board.won()); ++step) {
+                position pos;
+                pos.rows = rows, pos.cols = cols, pos.mines = mines;
+                board.getVisible(pos.cells);
+                solver.solve(pos.cells, rows, cols, mines);
+                if (not solver.exact()) {
+                    break;
+                }
+
+                /* save the opening, the midgame and the last guess near the end */
+                int revealed = rows * cols - count(pos.cells.begin(), pos.cells.end(), HIDDEN);
+                vector<Pos> safe = solver.safeCells();
+                if (step == 0) {
+                    stages[0].push_back(pos);
+                } else if ((not haveMid) and (revealed >= safeCells * MIDGAME_REVEALED)) {
+                    stages[1].push_back(pos);
+                    haveMid = true;
+                } else if (safe.empty() and (revealed >= safeCells * ENDGAME_REVEALED)) {
+                    lastGuess = pos;
+                }
+
+                /* play every safe cell or the best guess */
+                if (safe.empty()) {
+                    safe.push_back(solver.bestGuess());
+                }
+                for (size_t i = 0; (i < safe.size()) and (outcome != MINE_HIT); ++i) {
+                    outcome = board.move(safe[i].first, safe[i].second);
+                }
+            }
+            if (lastGuess.rows > 0) {
+                stages[2].push_back(lastGuess);
+            }
+
+            full = true;
+            for (int s = 0; s < NUM_STAGES; ++s) {
+                full = full and ((int)stages[s].size() >= POSITIONS_PER_STAGE);
+            }
+        }
+
+        /* write the first positions of each stage */
+        for (int s = 0; s < NUM_STAGES; ++s) {
+            for (int i = 0; i < POSITIONS_PER_STAGE; ++i) {
+                stages[s][i].name = DIFF_NAMES[diff] + "-" + STAGES[s] + "-" + to_string(i);
+                writePosition(out, stages[s][i]);
+            }
+        }
+    }
+}
+
+/*
+ * writePosition
+ * purpose: Write a position and its answers, found by countAnswers, to the
+ *          corpus
+ * parameters:
+ *      ostream &out : The corpus file
+ *      position &pos : The position
+ * returns: n/a
+ */
+static void writePosition(ostream &out, position &pos)
+{
+    vector<double> mineWays, safeWays;
+    countAnswers(pos, mineWays, safeWays);
+    out << "POSITION " << pos.name << " " << pos.rows << " " << pos.cols << " " << pos.mines << endl;
+
+    /* board */
+    for (int row = 0; row < pos.rows; ++row) {
+        for (int col = 0; col < pos.cols; ++col) {
+            int cell = pos.cells[(row * pos.cols) + col];
+            out << (cell == HIDDEN ? '.' : (char)('0' + cell));
+        }
+        out << endl;
+    }
+
+    /* answers */
+    vector<double> undecided;
+    for (int row = 0; row < pos.rows; ++row) {
+        for (int col = 0; col < pos.cols; ++col) {
+            int i = (row * pos.cols) + col;
+            if (pos.cells[i] != HIDDEN) {
+                out << ANS_SHOWN;
+            } else if (mineWays[i] == 0) {
+                out << ANS_SAFE;
+            } else if (safeWays[i] == 0) {
+                out << ANS_MINE;
+            } else {
+                out << ANS_OPEN;
+                undecided.push_back(mineWays[i] / (mineWays[i] + safeWays[i]));
+            }
+        }
+        out << endl;
+    }
+
+    /* probabilities of the undecided cells */
+    out << setprecision(10);
+    for (size_t i = 0; i < undecided.size(); ++i) {
+        out << (i ? " " : "") << undecided[i];
+    }
+    out << endl;
+}
+
+
+/******************************************************\
+ *                  Counting Answers                   *
+\******************************************************/
+
+/*
+ * countAnswers
+ * purpose: Count, for each hidden cell, the arrangements of the mines that
+ *          agree with every revealed number with the cell a mine and with it
+ *          safe
+ * parameters:
+ *           position &pos : The position
+ *      vector<double> &mineWays : Set to the arrangements with each cell a
+ *                                 mine
+ *      vector<double> &safeWays : Set to the arrangements with each cell safe
+ * returns: n/a
+ * note: Every arrangement of the cells next to the numbers is tried, one
+ *       group of cells that share numbers at a time, and the mines left over
+ *       can be anywhere in the other hidden cells. Slow, but it shares nothing
+ *       with the Solver, so the corpus checks the Solver.
+ */
+static void countAnswers(position &pos, vector<double> &mineWays, vector<double> &safeWays)
+{
+    int numCells = pos.rows * pos.cols;
+    mineWays.assign(numCells, 0);
+    safeWays.assign(numCells, 0);
+
+    /* the mines each number still needs and the hidden cells around it */
+    vector<int> need(numCells, 0), open(numCells, 0), group(numCells, -1);
+    int hidden = 0;
+    for (int i = 0; i < numCells; ++i) {
+        int row = i / pos.cols, col = i % pos.cols;
+        hidden += (pos.cells[i] == HIDDEN);
+        if (pos.cells[i] < 0) {
+            continue;
+        }
+        need[i] = pos.cells[i];
+        for (int r = max(0, row - 1); r <= min(pos.rows - 1, row + 1); ++r) {
+            for (int c = max(0, col - 1); c <= min(pos.cols - 1, col + 1); ++c) {
+                open[i] += (pos.cells[(r * pos.cols) + c] == HIDDEN);
+            }
+        }
+    }
+
+    /* group the hidden cells next to numbers, walking from cell to cell
+       through the numbers they share (so each cell tried is next to the
+       last ones and a wrong arrangement is found early) */
+    vector<frontGroup> groups;
+    for (int start = 0; start < numCells; ++start) {
+        if ((pos.cells[start] != HIDDEN) or (group[start] >= 0)) {
+            continue;
+        }
+        frontGroup front;
+        vector<int> queue(1, start);
+        group[start] = groups.size();
+        for (size_t q = 0; q < queue.size(); ++q) {
+            int row = queue[q] / pos.cols, col = queue[q] % pos.cols;
+            bool nextToNumber = false;
+            for (int r = max(0, row - 1); r <= min(pos.rows - 1, row + 1); ++r) {
+                for (int c = max(0, col - 1); c <= min(pos.cols - 1, col + 1); ++c) {
+                    if (pos.cells[(r * pos.cols) + c] < 0) {
+                        continue;
+                    }
+                    nextToNumber = true;
+                    for (int r2 = max(0, r - 1); r2 <= min(pos.rows - 1, r + 1); ++r2) {
+                        for (int c2 = max(0, c - 1); c2 <= min(pos.cols - 1, c + 1); ++c2) {
+                            int cell = (r2 * pos.cols) + c2;
+                            if ((pos.cells[cell] == HIDDEN) and (group[cell] < 0)) {
+                                group[cell] = groups.size();
+                                queue.push_back(cell);
+                            }
+                        }
+                    }
+                }
+            }
+            if (not nextToNumber) {
+                group[queue[q]] = -1;
+                break;
+            }
+        }
+        if (group[start] < 0) {
+            continue;
+        }
+        front.cells = queue;
+        front.arrangements.assign(front.cells.size() + 1, 0);
+        front.cellMines.assign(front.cells.size(), front.arrangements);
+        vector<int> mines(front.cells.size(), 0);
+        enumerate(pos, front, need, open, mines, 0, 0);
+        groups.push_back(front);
+    }
+
+    /* the hidden cells away from every number take the mines left over */
+    int loose = hidden;
+    for (size_t g = 0; g < groups.size(); ++g) {
+        loose -= groups[g].cells.size();
+    }
+    vector<double> looseWays(loose + 1, 1);
+    for (int k = 1; k <= loose; ++k) {
+        looseWays[k] = (looseWays[k - 1] * (loose - k + 1)) / k;
+    }
+
+    /* each group's cells, against every arrangement of the other groups */
+    for (size_t g = 0; g < groups.size(); ++g) {
+        vector<double> others = combine(groups, g);
+        for (size_t i = 0; i < groups[g].cells.size(); ++i) {
+            int cell = groups[g].cells[i];
+            for (size_t j = 0; j < groups[g].arrangements.size(); ++j) {
+                for (size_t k = 0; k < others.size(); ++k) {
+                    int left = pos.mines - (int)(j + k);
+                    if ((left < 0) or (left > loose)) {
+                        continue;
+                    }
+                    double ways = others[k] * looseWays[left];
+                    mineWays[cell] += groups[g].cellMines[i][j] * ways;
+                    safeWays[cell] += (groups[g].arrangements[j] - groups[g].cellMines[i][j]) * ways;
+                }
+            }
+        }
+    }
+
+    /* the cells away from every number are all alike */
+    vector<double> all = combine(groups, -1);
+    double looseMine = 0, looseSafe = 0;
+    for (size_t k = 0; (loose > 0) and (k < all.size()); ++k) {
+        int left = pos.mines - (int)k;
+        if ((left < 0) or (left > loose)) {
+            continue;
+        }
+        looseMine += (all[k] * looseWays[left] * left) / loose;
+        looseSafe += (all[k] * looseWays[left] * (loose - left)) / loose;
+    }
+    for (int i = 0; i < numCells; ++i) {
+        if ((pos.cells[i] == HIDDEN) and (group[i] < 0)) {
+            mineWays[i] = looseMine;
+            safeWays[i] = looseSafe;
+        }
+    }
+}
+
+/*
+ * enumerate
+ * purpose: Try both states of each of a group's cells in turn, counting the
+ *          arrangements that agree with every number
+ * parameters:
+ *           position &pos : The position
+ *      frontGroup &group : The group (its counts are added to)
+ *       vector<int> &need : Mines each number still needs
+ *       vector<int> &open : Hidden cells around each number not yet tried
+ *      vector<int> &mines : Whether each of the group's cells is a mine
+ *             size_t next : The cell to try next
+ *              int placed : Mines placed in the group so far
+ * returns: n/a
+ * note: need and open are put back as they were before returning
+ */
+static void enumerate(position &pos, frontGroup &group, vector<int> &need, vector<int> &open,
+                      vector<int> &mines, size_t next, int placed)
+{
+    if (next == group.cells.size()) {
+        group.arrangements[placed] += 1;
+        for (size_t i = 0; i < mines.size(); ++i) {
+            group.cellMines[i][placed] += mines[i];
+        }
+        return;
+    }
+
+    int row = group.cells[next] / pos.cols, col = group.cells[next] % pos.cols;
+    for (int mine = 0; mine <= 1; ++mine) {
+
+        /* place it, checking that every number around it can still be met */
+        bool fits = true;
+        for (int r = max(0, row - 1); r <= min(pos.rows - 1, row + 1); ++r) {
+            for (int c = max(0, col - 1); c <= min(pos.cols - 1, col + 1); ++c) {
+                int cell = (r * pos.cols) + c;
+                if (pos.cells[cell] < 0) {
+                    continue;
+                }
+                need[cell] -= mine;
+                --open[cell];
+                fits = fits and (need[cell] >= 0) and (need[cell] <= open[cell]);
+            }
+        }
+        if (fits) {
+            mines[next] = mine;
+            enumerate(pos, group, need, open, mines, next + 1, placed + mine);
+        }
+
+        /* take it back */
+        for (int r = max(0, row - 1); r <= min(pos.rows - 1, row + 1); ++r) {
+            for (int c = max(0, col - 1); c <= min(pos.cols - 1, col + 1); ++c) {
+                int cell = (r * pos.cols) + c;
+                if (pos.cells[cell] >= 0) {
+                    need[cell] += mine;
+                    ++open[cell];
+                }
+            }
+        }
+    }
+    mines[next] = 0;
+}
+
+/*
+ * combine
+ * purpose: Count the arrangements of several groups together
+ * parameters:
+ *      vector<frontGroup> &groups : The groups
+ *                        int skip : A group to leave out (-1 for none)
+ * returns: The arrangements of the groups with each count of mines
+ */
+static vector<double> combine(vector<frontGroup> &groups, int skip)
+{
+    vector<double> total(1, 1);
+    for (size_t g = 0; g < groups.size(); ++g) {
+        if ((int)g == skip) {
+            continue;
+        }
+        vector<double> both(total.size() + groups[g].arrangements.size() - 1, 0);
+        for (size_t i = 0; i < total.size(); ++i) {
+            for (size_t j = 0; j < groups[g].arrangements.size(); ++j) {
+                both[i + j] += total[i] * groups[g].arrangements[j];
+            }
+        }
+        total = both;
+    }
+    return total;
+}
@@ -0,0 +1,271 @@
+/*
+ * Project: minesweeper
+ * Name: Terminal.cpp
+ * Author: Tygan Chin
+ * Purpose: Plays minesweeper in a terminal (over ssh, without SFML) on the
+ *          game's Board, drawn by a TerminalRenderer. Move with the arrow
+ *          keys, hjkl or wasd, reveal a cell with the space bar or enter,
+ *          flag it with f, start a new game with n and quit with q. Only
+ *          what changed is sent to the terminal, and between key presses the
+ *          program sleeps until the clock's next second.
+ * Usage: ./terminal [easy|medium|hard] [seed]
+ */
+
+#include "../Files_h/Board.h"
+#include "../Files_h/TerminalRenderer.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+using namespace std;
+
+/* keys that aren't a single character */
+static const int KEY_UP    = 1000;
+static const int KEY_DOWN  = 1001;
+static const int KEY_RIGHT = 1002;
+static const int KEY_LEFT  = 1003;
+static const int CTRL_C    = 3;
+static const int CTRL_L    = 12;
+
+/* lines and columns the screen needs besides the board's */
+static const int EXTRA_LINES   = 4;
+static const int EXTRA_COLUMNS = 2;
+
+/* text below the board */
+static const string HELP_TEXT = "move: arrows/hjkl  reveal: space  flag: f  new: n  quit: q";
+static const string WON_TEXT  = "You won!  new: n  quit: q";
+static const string LOST_TEXT = "You hit a mine.  new: n  quit: q";
+
+/* the terminal's settings before the game, and whether it was resized */
+static termios original;
+static volatile sig_atomic_t resized = 0;
+
+/*
+ * restoreTerminal
+ * purpose: Put the terminal back the way it was before the game
+ * parameters: n/a
+ * returns: n/a
+ */
+void restoreTerminal()
+{
+    static const string LEAVE = "\x1b[0m\x1b[?1049l";
+    ssize_t ignored = write(STDOUT_FILENO, LEAVE.data(), LEAVE.size());
+    (void)ignored;
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &original);
+}
+
+/*
+ * onResize
+ * purpose: Note that the terminal was resized (the SIGWINCH handler)
+ * parameters:
+ *      int signal : The signal
+ * returns: n/a
+ */
+void onResize(int)
+{
+    resized = 1;
+}
+
+/*
+ * rawTerminal
+ * purpose: Read keys as they are pressed, without echoing them, on a screen
+ *          of the game's own that is put back when the program exits
+ * parameters: n/a
+ * returns: True if stdin is a terminal that could be set up, false otherwise
+ */
+bool rawTerminal()
+{
+    if (tcgetattr(STDIN_FILENO, &original) != 0) {
+        return false;
+    }
+    termios raw = original;
+    raw.c_lflag &= ~(ECHO | ICANON | ISIG | IEXTEN);
+    raw.c_iflag &= ~(IXON | ICRNL);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0) {
+        return false;
+    }
+    static const string ENTER = "\x1b[?1049h";
+    ssize_t ignored = write(STDOUT_FILENO, ENTER.data(), ENTER.size());
+    (void)ignored;
+    atexit(restoreTerminal);
+    signal(SIGWINCH, onResize);
+    return true;
+}
+
+/*
+ * readKeys
+ * purpose: Read the keys pressed since the last read
+ * parameters:
+ *      vector<int> &keys : Set to the keys (characters, or KEY_UP etc. for
+ *                          the arrows)
+ * returns: n/a
+ */
+void readKeys(vector<int> &keys)
+{
+    keys.clear();
+    char bytes[64];
+    ssize_t count = read(STDIN_FILENO, bytes, sizeof(bytes));
+    for (ssize_t i = 0; i < count; ++i) {
+        /* arrows are ESC [ A to D (or ESC O A to D) */
+        if ((bytes[i] == '\x1b') and (i + 2 < count) and
+            ((bytes[i + 1] == '[') or (bytes[i + 1] == 'O')) and
+            (bytes[i + 2] >= 'A') and (bytes[i + 2] <= 'D')) {
+            keys.push_back(KEY_UP + (bytes[i + 2] - 'A'));
+            i += 2;
+        } else {
+            keys.push_back((unsigned char)bytes[i]);
+        }
+    }
+}
+
+/*
+ * statusText
+ * purpose: Make the line above the board
+ * parameters:
+ *      int flags : Flags left
+ *      long time : Seconds since the game started
+ * returns: The flags left and the time (ex: "Flags: 10   Time:  1:05")
+ */
+string statusText(int flags, long time)
+{
+    stringstream status;
+    status << "Flags: " << setw(3) << flags << "   Time: " << setw(2) << time / 60
+           << ":" << setfill('0') << setw(2) << time % 60;
+    return status.str();
+}
+
+/*
+ * playGame
+ * purpose: Play one game in the terminal
+ * parameters:
+ *                       int diff : The difficulty (index of DIFF_NAMES)
+ *                  unsigned seed : Seed of the mines (if seeded)
+ *                    bool seeded : Whether to use the seed
+ *      TerminalRenderer &screen : The screen
+ * returns: True if the user wants a new game, false to quit
+ */
+bool playGame(int diff, unsigned seed, bool seeded, TerminalRenderer &screen)
+{
+    int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff];
+    Board board;
+    if (seeded) {
+        board.setSeed(seed);
+    }
+    board.setBoard(cols, rows, DIFF_BOMBS[diff]);
+    screen.setBoard(rows, cols);
+
+    Pos cursor(rows / 2, cols / 2);
+    string message = HELP_TEXT;
+    bool over = false;
+    long endTime = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<int> keys;
+    while (true) {
+
+        /* bring the screen up to date */
+        chrono::steady_clock::duration since = chrono::steady_clock::now() - start;
+        chrono::milliseconds elapsed = chrono::duration_cast<chrono::milliseconds>(since);
+        long time = over ? endTime : elapsed.count() / 1000;
+        if (not screen.draw(board, cursor, statusText(board.numFlags(), time), message)) {
+            return false;
+        }
+
+        /* sleep until a key is pressed or the clock's next second */
+        pollfd input = {STDIN_FILENO, POLLIN, 0};
+        int timeout = over ? -1 : 1000 - (elapsed.count() % 1000);
+        int ready = poll(&input, 1, timeout);
+        if (resized) {
+            resized = 0;
+            screen.invalidate();
+        }
+        if (ready <= 0) {
+            continue;
+        }
+
+        readKeys(keys);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            int key = keys[i];
+
+            /* keys that work at any time */
+            if ((key == 'q') or (key == CTRL_C)) {
+                return false;
+            } else if (key == 'n') {
+                return true;
+            } else if (key == CTRL_L) {
+                screen.invalidate();
+            } else if (over) {
+                continue;
+
+            /* move, reveal or flag */
+            } else if ((key == KEY_UP) or (key == 'k') or (key == 'w')) {
+                cursor.first = max(0, cursor.first - 1);
+            } else if ((key == KEY_DOWN) or (key == 'j') or (key == 's')) {
+                cursor.first = min(rows - 1, cursor.first + 1);
+            } else if ((key == KEY_LEFT) or (key == 'h') or (key == 'a')) {
+                cursor.second = max(0, cursor.second - 1);
+            } else if ((key == KEY_RIGHT) or (key == 'l') or (key == 'd')) {
+                cursor.second = min(cols - 1, cursor.second + 1);
+            } else if ((key == 'f') or (key == 'F')) {
+                board.placeFlag(cursor.first, cursor.second);
+            } else if (((key == ' ') or (key == '\r')) and (not board.isFlag(cursor.first, cursor.second))) {
+                bool hit = (board.move(cursor.first, cursor.second) == MINE_HIT);
+
+                /* show every mine once the game is over */
+                if ((hit) or (board.won())) {
+                    over = true;
+                    endTime = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - start).count();
+                    message = hit ? LOST_TEXT : WON_TEXT;
+                    while (board.revealMine()) {}
+                }
+            }
+        }
+    }
+}
+
+/*
+ * main
+ * purpose: Set up the terminal and play games until the user quits
+ * parameters: See usage above
+ * returns: 0, or 1 if the arguments or the terminal are unusable
+ */
+int main(int argc, char *argv[])
+{
+    int diff = (argc > 1) ? find(DIFF_NAMES, DIFF_NAMES + NUM_DIFFS, string(argv[1])) - DIFF_NAMES : 0;
+    if (diff == NUM_DIFFS) {
+        cerr << "usage: ./terminal [easy|medium|hard] [seed]" << endl;
+        return 1;
+    }
+    bool seeded = (argc > 2);
+    unsigned seed = seeded ? atoi(argv[2]) : 0;
+
+    /* the board, its status and message lines must fit on the screen */
+    winsize window;
+    int lines = DIFF_ROWS[diff] + EXTRA_LINES;
+    int columns = max((2 * DIFF_COLS[diff]) + EXTRA_COLUMNS, (int)HELP_TEXT.size());
+    if ((ioctl(STDOUT_FILENO, TIOCGWINSZ, &window) == 0) and
+        ((window.ws_row < lines) or (window.ws_col < columns))) {
+        cerr << "the terminal must be at least " << columns << "x" << lines << endl;
+        return 1;
+    }
+    if (not rawTerminal()) {
+        cerr << "stdin must be a terminal" << endl;
+        return 1;
+    }
+
+    TerminalRenderer screen;
+    for (unsigned game = 0; playGame(diff, seed + game, seeded, screen); ++game) {}
+    return 0;
+}
@@ -0,0 +1,364 @@
+/*
+ * Project: minesweeper
+ * Name: Tournament.cpp
+ * Author: Tygan Chin
+ * Purpose: Plays bots against each other on the same boards. Bots are loaded
+ *          from shared libraries (see BotPlugin.h) and the game's own Bot is
+ *          always entered as "solver". Games are shared out to a thread per
+ *          core, and every bot plays game i on the board dealt from seed + i
+ *          with the first click in the middle. Each bot's win rate, mean time
+ *          per decision, and 3BV per second of won games are written to a CSV
+ *          file.
+ * Usage: ./tournament <csv> <games> <easy|medium|hard> [bot.so ...]
+ */
+
+#include "../Files_h/BotPlugin.h"
+#include "../Files_h/Board.h"
+#include "../Files_h/Bot.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <dlfcn.h>
+
+using namespace std;
+
+/* seed of game 0 */
+static const unsigned BASE_SEED = 1;
+
+/* the view is handed to the bots as getVisible fills it, so the value
+   BotPlugin.h spells out by hand must stay the game's */
+static_assert(BOT_HIDDEN == HIDDEN, "BOT_HIDDEN must equal HIDDEN");
+
+/* a bot's totals */
+struct botTotals {
+    long games;
+    long wins;
+    long decisions;
+    double seconds;
+    long wonBBBV;
+    double wonSeconds;
+};
+
+/* state shared by the workers (the totals are kept per worker and bot) */
+struct tournament {
+    vector<const botPlugin *> bots;
+    int diff;
+    long games;
+    atomic<long> nextGame;
+};
+
+
+/******************************************************\
+ *                  Built in Bot                       *
+\******************************************************/
+
+/* the game's Bot and a copy of the view in the form it takes */
+struct solverBot {
+    Bot bot;
+    vector<int> cells;
+};
+
+/*
+ * solverCreate
+ * purpose: Make a state for the game's Bot (see BotPlugin.h)
+ * parameters:
+ *      unsigned : Unused (the Bot doesn't guess randomly)
+ * returns: The state
+ */
+static void *solverCreate(unsigned)
+{
+    return new solverBot;
+}
+
+/*
+ * solverDestroy
+ * purpose: Free a state made by solverCreate
+ * parameters:
+ *      void *state : The state
+ * returns: n/a
+ */
+static void solverDestroy(void *state)
+{
+    delete static_cast<solverBot *>(state);
+}
+
+/*
+ * solverChoose
+ * purpose: Choose the clicks with the game's Bot (see BotPlugin.h)
+ * parameters:
+ *               void *state : The state
+ *       const botView *view : The visible board
+ *            botMove *moves : Filled with the clicks
+ *              int maxMoves : Room in moves
+ * returns: The number of clicks
+ */
+static int solverChoose(void *state, const botView *view, botMove *moves, int maxMoves)
+{
+    solverBot *solver = static_cast<solverBot *>(state);
+    solver->cells.assign(view->cells, view->cells + (view->rows * view->cols));
+    vector<Pos> chosen = solver->bot.nextMoves(solver->cells, view->rows, view->cols, view->mines);
+    int count = min((int)chosen.size(), maxMoves);
+    for (int i = 0; i < count; ++i) {
+        moves[i].row = chosen[i].first;
+        moves[i].col = chosen[i].second;
+    }
+    return count;
+}
+
+static const botPlugin SOLVER_BOT = {BOT_PLUGIN_VERSION, "solver", solverCreate, solverDestroy, solverChoose};
+
+
+/******************************************************\
+ *                  Helper Functions                   *
+\******************************************************/
+
+/*
+ * loadBot
+ * purpose: Load a bot from a shared library
+ * parameters:
+ *      const string &path : Path of the library
+ * returns: The bot's functions, or NULL if it couldn't be loaded
+ * note: The library stays loaded until the program exits
+ */
+const botPlugin *loadBot(const string &path)
+{
+    void *library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library == NULL) {
+        cerr << dlerror() << endl;
+        return NULL;
+    }
+    botPluginEntry entry = reinterpret_cast<botPluginEntry>(dlsym(library, BOT_PLUGIN_ENTRY));
+    const botPlugin *bot = (entry == NULL) ? NULL : entry();
+    if ((bot == NULL) or (bot->version != BOT_PLUGIN_VERSION)) {
+        cerr << path << ": not a version " << BOT_PLUGIN_VERSION << " bot" << endl;
+        return NULL;
+    }
+    return bot;
+}
+
+/*
+ * threeBV
+ * purpose: Find the least number of clicks that clears a board (its 3BV):
+ *          one per opening plus one per number not next to an opening
+ * parameters:
+ *                    int rows : Number of rows on the board
+ *                    int cols : Number of columns on the board
+ *      const vector<Pos> &mines : The mine locations
+ * returns: The board's 3BV
+ */
+int threeBV(int rows, int cols, const vector<Pos> &mines)
+{
+    /* count the mines around each cell */
+    vector<int> number(rows * cols, 0);
+    for (size_t i = 0; i < mines.size(); ++i) {
+        for (int r = mines[i].first - 1; r <= mines[i].first + 1; ++r) {
+            for (int c = mines[i].second - 1; c <= mines[i].second + 1; ++c) {
+                if ((r >= 0) and (r < rows) and (c >= 0) and (c < cols)) {
+                    ++number[(r * cols) + c];
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < mines.size(); ++i) {
+        number[(mines[i].first * cols) + mines[i].second] = MINE;
+    }
+
+    /* open each zero that hasn't been opened yet, counting one click each */
+    vector<bool> opened(rows * cols, false);
+    int clicks = 0;
+    for (int start = 0; start < rows * cols; ++start) {
+        if ((number[start] != 0) or opened[start]) {
+            continue;
+        }
+        ++clicks;
+        vector<int> stack(1, start);
+        opened[start] = true;
+        while (not stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            for (int r = (cell / cols) - 1; r <= (cell / cols) + 1; ++r) {
+                for (int c = (cell % cols) - 1; c <= (cell % cols) + 1; ++c) {
+                    int next = (r * cols) + c;
+                    if ((r < 0) or (r >= rows) or (c < 0) or (c >= cols) or opened[next]) {
+                        continue;
+                    }
+                    opened[next] = true;
+                    if (number[next] == 0) {
+                        stack.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    /* then every number the openings didn't reveal */
+    for (int cell = 0; cell < rows * cols; ++cell) {
+        clicks += (number[cell] > 0) and (not opened[cell]);
+    }
+    return clicks;
+}
+
+/*
+ * playGame
+ * purpose: Play one game with a bot
+ * parameters:
+ *      const botPlugin *bot : The bot
+ *               void *state : The bot's state
+ *                  int diff : The difficulty
+ *             unsigned seed : Seed of the board
+ *        botTotals &totals : The bot's totals to add the game to
+ * returns: n/a
+ * note: The bot loses if it gives up or only clicks cells that are shown or
+ *       out of bounds. Only the first moves.size() moves it returns are read.
+ */
+void playGame(const botPlugin *bot, void *state, int diff, unsigned seed, botTotals &totals)
+{
+    int rows = DIFF_ROWS[diff], cols = DIFF_COLS[diff];
+    Board board;
+    board.setSeed(seed);
+    board.setBoard(cols, rows, DIFF_BOMBS[diff]);
+    int outcome = board.move(rows / 2, cols / 2);
+
+    vector<int> cells;
+    vector<botMove> moves(rows * cols);
+    botView view = {rows, cols, DIFF_BOMBS[diff], NULL};
+    double seconds = 0;
+    bool moved = true;
+    while (moved and (outcome != MINE_HIT) and (not board.won())) {
+
+        /* time the bot's decision */
+        board.getVisible(cells);
+        view.cells = cells.data();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int count = bot->choose(state, &view, moves.data(), moves.size());
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        count = max(0, min(count, (int)moves.size()));
+        seconds += elapsed.count();
+        ++totals.decisions;
+
+        /* make the clicks that are on hidden cells */
+        moved = false;
+        for (int i = 0; (i < count) and (outcome != MINE_HIT); ++i) {
+            int row = moves[i].row, col = moves[i].col;
+            if ((row >= 0) and (row < rows) and (col >= 0) and (col < cols) and (not board.isShown(row, col))) {
+                outcome = board.move(row, col);
+                moved = true;
+            }
+        }
+    }
+
+    ++totals.games;
+    totals.seconds += seconds;
+    if (board.won()) {
+        ++totals.wins;
+        totals.wonBBBV += threeBV(rows, cols, board.getMines());
+        totals.wonSeconds += seconds;
+    }
+}
+
+/*
+ * work
+ * purpose: Play games with every bot until the games run out
+ * parameters:
+ *              tournament *shared : The bots and games
+ *      vector<botTotals> *totals : This worker's totals (one per bot)
+ *               unsigned worker : Index of the worker (seeds the bots)
+ * returns: n/a
+ * note: Runs on a worker thread. Only this worker writes its totals.
+ */
+void work(tournament *shared, vector<botTotals> *totals, unsigned worker)
+{
+    vector<void *> states;
+    for (size_t i = 0; i < shared->bots.size(); ++i) {
+        states.push_back(shared->bots[i]->create(BASE_SEED + worker));
+    }
+    for (long game = shared->nextGame++; game < shared->games; game = shared->nextGame++) {
+        for (size_t i = 0; i < shared->bots.size(); ++i) {
+            playGame(shared->bots[i], states[i], shared->diff, BASE_SEED + game, (*totals)[i]);
+        }
+    }
+    for (size_t i = 0; i < shared->bots.size(); ++i) {
+        shared->bots[i]->destroy(states[i]);
+    }
+}
+
+
+/******************************************************\
+ *                        Main                         *
+\******************************************************/
+
+/*
+ * main
+ * purpose: Load the bots, play the tournament, and write the results
+ * parameters: See usage above
+ * returns: 0 if the tournament was played, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    tournament shared;
+    shared.diff = (argc > 3) ? find(DIFF_NAMES, DIFF_NAMES + NUM_DIFFS, string(argv[3])) - DIFF_NAMES : NUM_DIFFS;
+    if (shared.diff == NUM_DIFFS) {
+        cerr << "usage: ./tournament <csv> <games> <easy|medium|hard> [bot.so ...]" << endl;
+        return 1;
+    }
+    shared.games = max(1L, atol(argv[2]));
+    shared.nextGame = 0;
+    shared.bots.push_back(&SOLVER_BOT);
+    for (int i = 4; i < argc; ++i) {
+        const botPlugin *bot = loadBot(argv[i]);
+        if (bot == NULL) {
+            return 1;
+        }
+        shared.bots.push_back(bot);
+    }
+
+    /* play the games with a set of totals per worker */
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    botTotals empty = {0, 0, 0, 0, 0, 0};
+    vector<vector<botTotals> > totals(threads, vector<botTotals>(shared.bots.size(), empty));
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.push_back(thread(work, &shared, &totals[i], i));
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers[i].join();
+    }
+
+    /* add up the workers and write each bot's results */
+    ofstream csv(argv[1]);
+    if (not csv.is_open()) {
+        cerr << "could not write " << argv[1] << endl;
+        return 1;
+    }
+    csv << "bot,difficulty,games,wins,win_rate,mean_decision_us,3bv_per_s\n";
+    cout << shared.games << " " << DIFF_NAMES[shared.diff] << " games, " << threads << " threads" << endl
+         << left << setw(12) << "bot" << right << setw(9) << "win %" << setw(14)
+         << "decision us" << setw(10) << "3BV/s" << endl;
+    for (size_t i = 0; i < shared.bots.size(); ++i) {
+        botTotals sum = empty;
+        for (unsigned j = 0; j < threads; ++j) {
+            sum.games += totals[j][i].games;
+            sum.wins += totals[j][i].wins;
+            sum.decisions += totals[j][i].decisions;
+            sum.seconds += totals[j][i].seconds;
+            sum.wonBBBV += totals[j][i].wonBBBV;
+            sum.wonSeconds += totals[j][i].wonSeconds;
+        }
+        double winRate = (double)sum.wins / sum.games;
+        double decision = 1e6 * sum.seconds / max(1L, sum.decisions);
+        double bbbvPerSecond = (sum.wonSeconds > 0) ? sum.wonBBBV / sum.wonSeconds : 0;
+        csv << shared.bots[i]->name << "," << DIFF_NAMES[shared.diff] << "," << sum.games
+            << "," << sum.wins << "," << winRate << "," << decision << "," << bbbvPerSecond << "\n";
+        cout << left << setw(12) << shared.bots[i]->name << right << fixed << setprecision(2)
+             << setw(9) << 100 * winRate << setw(14) << decision << setprecision(0)
+             << setw(10) << bbbvPerSecond << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,251 @@
+/*
+ * Project: minesweeper
+ * Name: TrainExport.cpp
+ * Author: Tygan Chin
+ * Purpose: Exports positions labeled by the Solver for training models. Plays
+ *          games with the Bot's strategy on every core, and at every turn 
+ *          writes a record for each hidden cell next to a revealed cell: the
+ *          cells around it as the user sees them, whether it is really a 
+ *          mine, and the Solver's probability that it is. Each thread fills
+ *          its own buffer and writes it as one chunk when full, so memory
+ *          stays bounded and the file is written in large sequential pieces.
+ * Format: A trainHeader, then chunks. Each chunk is a uint32 record count and
+ *         that many trainRecords (see below). Chunks from different threads
+ *         are interleaved in no particular order.
+ * Usage: ./trainexport <file> <samples> <easy|medium|hard> [seed]
+ */
+
+#include "../Files_h/Board.h"
+#include "../Files_h/Solver.h"
+#include "../Files_h/Game_Constants.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
+
+/* cells on each side of the labeled cell in a record's window */
+static const int WINDOW_RADIUS = 2;
+static const int WINDOW_SIZE = (2 * WINDOW_RADIUS) + 1;
+
+/* value of a window cell that is off the board (hidden cells are HIDDEN),
+   which must not be mistaken for any value a cell on the board can have */
+static const int OFF_BOARD = -4;
+static_assert((OFF_BOARD != HIDDEN) and (OFF_BOARD != FLAGGED) and (OFF_BOARD != MINE),
+              "OFF_BOARD must differ from every cell value");
+
+/* records a thread buffers before writing them as a chunk */
+static const uint32_t CHUNK_RECORDS = 1 << 16;
+
+/* start of the file */
+struct trainHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t windowSize;
+    uint32_t recordSize;
+    uint32_t difficulty;
+};
+
+/* one labeled cell (32 bytes) */
+struct trainRecord {
+    int8_t window[WINDOW_SIZE * WINDOW_SIZE];
+    uint8_t mine;
+    uint8_t pad[2];
+    float probability;
+};
+
+static const char TRAIN_MAGIC[8] = {'M', 'S', 'T', 'R', 'A', 'I', 'N', 0};
+static const uint32_t TRAIN_VERSION = 2;
+
+/* state shared by the workers */
+struct exportShared {
+    int diff;
+    unsigned seed;
+    long samples;
+    atomic<long> reserved;
+    atomic<long> nextGame;
+    mutex fileLock;
+    ofstream output;
+    double writeSeconds;
+};
+
+/*
+ * flush
+ * purpose: Write a thread's buffered records as a chunk, keeping only as
+ *          many as are still needed
+ * parameters:
+ *             exportShared *shared : The file and the samples wanted
+ *      vector<trainRecord> &buffer : The thread's records (emptied)
+ * returns: False once every sample has been written
+ */
+bool flush(exportShared *shared, vector<trainRecord> &buffer)
+{
+    long first = shared->reserved.fetch_add(buffer.size());
+    uint32_t keep = max(0L, min((long)buffer.size(), shared->samples - first));
+    if (keep > 0) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        lock_guard<mutex> guard(shared->fileLock);
+        shared->output.write(reinterpret_cast<const char *>(&keep), sizeof(keep));
+        shared->output.write(reinterpret_cast<const char *>(buffer.data()), keep * sizeof(trainRecord));
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        shared->writeSeconds += elapsed.count();
+    }
+    buffer.clear();
+    return first + keep < shared->samples;
+}
+
+/*
+ * addRecords
+ * purpose: Label every hidden cell next to a revealed cell
+ * parameters:
+ *      const vector<int> &cells : The visible board (see Board::getVisible)
+ *      const vector<bool> &mine : Whether each cell is really a mine
+ *                Solver &solver : Solved for the visible board
+ *                      int rows : Number of rows on the board
+ *                      int cols : Number of columns on the board
+ *   vector<trainRecord> &buffer : The records are added to the end
+ * returns: n/a
+ */
+void addRecords(const vector<int> &cells, const vector<bool> &mine, Solver &solver,
+                int rows, int cols, vector<trainRecord> &buffer)
+{
+    for (int cell = 0; cell < rows * cols; ++cell) {
+        if (cells[cell] != HIDDEN) {
+            continue;
+        }
+
+        /* copy the window, noting whether any of it is revealed */
+        trainRecord record;
+        memset(&record, 0, sizeof(record));
+        int row = cell / cols, col = cell % cols, i = 0;
+        bool frontier = false;
+        for (int r = row - WINDOW_RADIUS; r <= row + WINDOW_RADIUS; ++r) {
+            for (int c = col - WINDOW_RADIUS; c <= col + WINDOW_RADIUS; ++c, ++i) {
+                bool onBoard = (r >= 0) and (r < rows) and (c >= 0) and (c < cols);
+                record.window[i] = onBoard ? cells[(r * cols) + c] : OFF_BOARD;
+                bool adjacent = (abs(r - row) <= 1) and (abs(c - col) <= 1);
+                frontier = frontier or (adjacent and onBoard and (record.window[i] != HIDDEN));
+            }
+        }
+        if (frontier) {
+            record.mine = mine[cell];
+            record.probability = solver.mineProbability(row, col);
+            buffer.push_back(record);
+        }
+    }
+}
+
+/*
+ * work
+ * purpose: Play games and export their positions until enough samples have
+ *          been written
+ * parameters:
+ *      exportShared *shared : The file and the samples wanted
+ * returns: n/a
+ * note: Runs on a worker thread. Game i is dealt from seed + i.
+ */
+void work(exportShared *shared)
+{
+    int rows = DIFF_ROWS[shared->diff], cols = DIFF_COLS[shared->diff];
+    int mines = DIFF_BOMBS[shared->diff];
+    Solver solver;
+    vector<int> cells;
+    vector<trainRecord> buffer;
+    buffer.reserve(CHUNK_RECORDS + (rows * cols));
+
+    bool more = true;
+    while (more) {
+        Board board;
+        board.setSeed(shared->seed + shared->nextGame++);
+        board.setBoard(cols, rows, mines);
+        int outcome = board.move(rows / 2, cols / 2);
+        vector<bool> mine(rows * cols, false);
+        vector<Pos> layout = board.getMines();
+        for (size_t i = 0; i < layout.size(); ++i) {
+            mine[(layout[i].first * cols) + layout[i].second] = true;
+        }
+
+        /* label each turn, then click the safe cells or the best guess */
+        while (more and (outcome != MINE_HIT) and (not board.won())) {
+            board.getVisible(cells);
+            solver.solve(cells, rows, cols, mines);
+            addRecords(cells, mine, solver, rows, cols, buffer);
+            if (buffer.size() >= CHUNK_RECORDS) {
+                more = flush(shared, buffer);
+            }
+            vector<Pos> moves = solver.safeCells();
+            if (moves.empty()) {
+                moves.push_back(solver.bestGuess());
+            }
+            for (size_t i = 0; (i < moves.size()) and (outcome != MINE_HIT); ++i) {
+                outcome = board.move(moves[i].first, moves[i].second);
+            }
+        }
+        more = more and (shared->reserved < shared->samples);
+    }
+    if (not buffer.empty()) {
+        flush(shared, buffer);
+    }
+}
+
+/*
+ * main
+ * purpose: Export the samples and print the rate they were made and written
+ * parameters: See usage above
+ * returns: 0 if the file was written, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    exportShared shared;
+    shared.diff = (argc > 3) ? find(DIFF_NAMES, DIFF_NAMES + NUM_DIFFS, string(argv[3])) - DIFF_NAMES : NUM_DIFFS;
+    if (shared.diff == NUM_DIFFS) {
+        cerr << "usage: ./trainexport <file> <samples> <easy|medium|hard> [seed]" << endl;
+        return 1;
+    }
+    shared.samples = max(1L, atol(argv[2]));
+    shared.seed = (argc > 4) ? atoi(argv[4]) : 1;
+    shared.reserved = shared.nextGame = 0;
+    shared.writeSeconds = 0;
+    shared.output.open(argv[1], ios::binary);
+    if (not shared.output.is_open()) {
+        cerr << "could not write " << argv[1] << endl;
+        return 1;
+    }
+    trainHeader header = {{0}, TRAIN_VERSION, WINDOW_SIZE, sizeof(trainRecord), (uint32_t)shared.diff};
+    memcpy(header.magic, TRAIN_MAGIC, sizeof(TRAIN_MAGIC));
+    shared.output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    /* play and export on every core */
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.push_back(thread(work, &shared));
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers[i].join();
+    }
+    shared.output.close();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    if (not shared.output.good()) {
+        cerr << "could not write " << argv[1] << endl;
+        return 1;
+    }
+
+    double megabytes = shared.samples * sizeof(trainRecord) / 1e6;
+    cout << shared.samples << " samples from " << shared.nextGame << " " << DIFF_NAMES[shared.diff]
+         << " games, " << threads << " threads" << endl << fixed << setprecision(0)
+         << shared.samples / elapsed.count() << " samples/s, " << setprecision(1)
+         << megabytes / elapsed.count() << " MB/s, " 
+         << 100 * shared.writeSeconds / (elapsed.count() * threads) << "% of thread time writing" << endl;
+    return 0;
+}